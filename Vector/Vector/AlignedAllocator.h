@@ -0,0 +1,180 @@
+#ifndef ALIGNED_ALLOCATOR_H
+
+#define ALIGNED_ALLOCATOR_H
+
+#include "Vector.h"
+
+#include <type_traits>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <mutex>
+#include <unordered_set>
+#endif
+
+enum class PageMode
+{
+	Normal,
+	// Big buffers are aligned to a huge page and advised to use transparent huge pages.
+	// Linux only, elsewhere it acts like Normal
+	Huge
+};
+
+// Buffers at least this big get huge pages in PageMode::Huge
+const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+#if defined(__linux__)
+// The huge buffers madvise accepted, shared by every AlignedAllocator. They are at least HUGE_PAGE_SIZE each,
+// so there are never many and the lock costs nothing next to the allocation
+struct HugeBuffers
+{
+	std::mutex mutex;
+	std::unordered_set<void*> advised;
+};
+
+inline HugeBuffers& hugeBuffers()
+{
+	static HugeBuffers buffers;
+	return buffers;
+}
+#endif
+
+// std compatible allocator that aligns every buffer to Alignment bytes (64 is a cache line and an AVX-512 register).
+// Stateless, so a Vector using it is no bigger than with std::allocator
+template <typename Type, std::size_t Alignment = 64, PageMode Mode = PageMode::Normal>
+class AlignedAllocator
+{
+	static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+public:
+	using value_type = Type;
+	using is_always_equal = std::true_type;
+
+	// The non-type parameters keep std::allocator_traits from doing this on its own
+	template <typename Other>
+	struct rebind
+	{
+		using other = AlignedAllocator<Other, Alignment, Mode>;
+	};
+
+	AlignedAllocator() noexcept = default;
+
+	template <typename Other>
+	AlignedAllocator(const AlignedAllocator<Other, Alignment, Mode>&) noexcept {}
+
+	Type* allocate(std::size_t count)
+	{
+		if (count > max_size())
+			throw std::bad_array_new_length();
+
+		std::size_t bytes = sizeof(Type) * count;
+
+		if (!isHuge(bytes))
+			return static_cast<Type*>(::operator new(bytes, std::align_val_t(alignment())));
+
+#if defined(__linux__)
+		// Whole huge pages, so the tail of the buffer gets one too
+		bytes = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+		void* data = ::operator new(bytes, std::align_val_t(HUGE_PAGE_SIZE));
+
+		if (::madvise(data, bytes, MADV_HUGEPAGE) == 0)
+		{
+			try
+			{
+				HugeBuffers& buffers = hugeBuffers();
+				std::lock_guard<std::mutex> lock(buffers.mutex);
+				buffers.advised.insert(data);
+			}
+			catch (...)
+			{
+				::operator delete(data, std::align_val_t(HUGE_PAGE_SIZE));
+				throw;
+			}
+		}
+
+		return static_cast<Type*>(data);
+#else
+		return static_cast<Type*>(::operator new(bytes, std::align_val_t(alignment())));
+#endif
+	}
+
+	void deallocate(Type* data, std::size_t count) noexcept
+	{
+		// count came from allocate, so it is at most max_size() and this can not overflow
+		std::size_t bytes = sizeof(Type) * count;
+
+#if defined(__linux__)
+		if (isHuge(bytes))
+		{
+			HugeBuffers& buffers = hugeBuffers();
+
+			{
+				std::lock_guard<std::mutex> lock(buffers.mutex);
+				buffers.advised.erase(data);
+			}
+
+			::operator delete(data, std::align_val_t(HUGE_PAGE_SIZE));
+			return;
+		}
+#endif
+
+		::operator delete(data, std::align_val_t(alignment()));
+	}
+
+	// The most elements one buffer can hold. Huge buffers are rounded up to whole pages, so they need a page of room on top
+	static constexpr std::size_t max_size() noexcept
+	{
+		return (std::numeric_limits<std::size_t>::max() - (Mode == PageMode::Huge ? HUGE_PAGE_SIZE : 0)) / sizeof(Type);
+	}
+
+	// Whether this buffer of count elements, which came from this allocator, was advised to use huge pages.
+	// Vector::storageInfo asks this
+	bool usesHugePages(const Type* data, std::size_t count) const noexcept
+	{
+#if defined(__linux__)
+		if (!isHuge(sizeof(Type) * count))
+			return false;
+
+		HugeBuffers& buffers = hugeBuffers();
+		std::lock_guard<std::mutex> lock(buffers.mutex);
+
+		return buffers.advised.count(const_cast<Type*>(data)) > 0;
+#else
+		(void)data;
+		(void)count;
+		return false;
+#endif
+	}
+
+private:
+	static constexpr std::size_t alignment()
+	{
+		// Never less than what the type needs
+		return Alignment < alignof(Type) ? alignof(Type) : Alignment;
+	}
+
+	static bool isHuge(std::size_t bytes)
+	{
+		return Mode == PageMode::Huge && bytes >= HUGE_PAGE_SIZE;
+	}
+};
+
+template <typename Lhs, typename Rhs, std::size_t Alignment, PageMode Mode>
+bool operator== (const AlignedAllocator<Lhs, Alignment, Mode>&, const AlignedAllocator<Rhs, Alignment, Mode>&)
+{
+	return true;
+}
+
+template <typename Lhs, typename Rhs, std::size_t Alignment, PageMode Mode>
+bool operator!= (const AlignedAllocator<Lhs, Alignment, Mode>&, const AlignedAllocator<Rhs, Alignment, Mode>&)
+{
+	return false;
+}
+
+template <typename Type, std::size_t Alignment = 64, PageMode Mode = PageMode::Normal, typename GrowthPolicy = GeometricGrowth<>>
+using AlignedVector = Vector<Type, GrowthPolicy, AlignedAllocator<Type, Alignment, Mode>>;
+
+#endif // !ALIGNED_ALLOCATOR_H
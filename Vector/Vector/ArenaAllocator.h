@@ -0,0 +1,204 @@
+#ifndef ARENA_ALLOCATOR_H
+
+#define ARENA_ALLOCATOR_H
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+// Hands out memory by bumping a pointer through big blocks and never frees anything on its own.
+// Everything allocated from it is released at once by reset() or when the arena dies,
+// so objects living in it must not need their memory back before that.
+class MonotonicArena
+{
+public:
+	explicit MonotonicArena(std::size_t blockSize = 64 * 1024);
+	MonotonicArena(const MonotonicArena& other) = delete;
+	~MonotonicArena();
+
+	MonotonicArena& operator= (const MonotonicArena& other) = delete;
+
+	void* allocate(std::size_t bytes, std::size_t alignment);
+
+	// Frees every block except the biggest one, which is kept for reuse
+	void reset();
+
+	std::size_t bytesUsed() const;
+	std::size_t bytesReserved() const;
+
+private:
+	struct Block
+	{
+		Block* next;
+		std::size_t size;
+	};
+
+	// The header is padded so the usable memory starts at the strictest fundamental alignment
+	static constexpr std::size_t headerSize = (sizeof(Block) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+	Block* m_Blocks;
+	char* m_Current;
+	char* m_End;
+	std::size_t m_BlockSize;
+	std::size_t m_Used;
+	std::size_t m_Reserved;
+
+	void addBlock(std::size_t minSize);
+	static char* blockBegin(Block* block);
+};
+
+// std compatible allocator on top of a MonotonicArena. deallocate does nothing
+template <typename Type>
+class ArenaAllocator
+{
+public:
+	using value_type = Type;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	ArenaAllocator(MonotonicArena& arena) noexcept : m_Arena(&arena) {}
+
+	template <typename Other>
+	ArenaAllocator(const ArenaAllocator<Other>& other) noexcept : m_Arena(other.arena()) {}
+
+	Type* allocate(std::size_t count)
+	{
+		if (count > max_size())
+			throw std::bad_array_new_length();
+
+		return static_cast<Type*>(m_Arena->allocate(sizeof(Type) * count, alignof(Type)));
+	}
+
+	void deallocate(Type*, std::size_t) noexcept {}
+
+	static constexpr std::size_t max_size() noexcept
+	{
+		return std::numeric_limits<std::size_t>::max() / sizeof(Type);
+	}
+
+	MonotonicArena* arena() const noexcept
+	{
+		return m_Arena;
+	}
+
+private:
+	MonotonicArena* m_Arena;
+};
+
+template <typename Lhs, typename Rhs>
+bool operator== (const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs)
+{
+	return lhs.arena() == rhs.arena();
+}
+
+template <typename Lhs, typename Rhs>
+bool operator!= (const ArenaAllocator<Lhs>& lhs, const ArenaAllocator<Rhs>& rhs)
+{
+	return lhs.arena() != rhs.arena();
+}
+
+inline MonotonicArena::MonotonicArena(std::size_t blockSize)
+	: m_Blocks(nullptr), m_Current(nullptr), m_End(nullptr), m_BlockSize(blockSize), m_Used(0), m_Reserved(0)
+{
+	if (m_BlockSize < 256)
+		m_BlockSize = 256;
+}
+
+inline MonotonicArena::~MonotonicArena()
+{
+	while (m_Blocks)
+	{
+		Block* next = m_Blocks->next;
+		::operator delete(m_Blocks);
+		m_Blocks = next;
+	}
+}
+
+inline void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment)
+{
+	if (alignment > alignof(std::max_align_t))
+		throw std::bad_alloc();
+
+	std::size_t padding = m_Current ? (alignment - reinterpret_cast<std::uintptr_t>(m_Current) % alignment) % alignment : 0;
+
+	// Not bytes + padding, that could wrap around
+	if (!m_Current || padding > static_cast<std::size_t>(m_End - m_Current) || bytes > static_cast<std::size_t>(m_End - m_Current) - padding)
+	{
+		addBlock(bytes);
+		padding = 0;
+	}
+
+	char* result = m_Current + padding;
+	m_Current = result + bytes;
+	m_Used += bytes + padding;
+
+	return result;
+}
+
+inline void MonotonicArena::reset()
+{
+	if (!m_Blocks)
+		return;
+
+	Block* biggest = m_Blocks;
+
+	for (Block* block = m_Blocks; block; block = block->next)
+	{
+		if (block->size > biggest->size)
+			biggest = block;
+	}
+
+	while (m_Blocks)
+	{
+		Block* next = m_Blocks->next;
+
+		if (m_Blocks != biggest)
+			::operator delete(m_Blocks);
+
+		m_Blocks = next;
+	}
+
+	biggest->next = nullptr;
+	m_Blocks = biggest;
+	m_Current = blockBegin(biggest);
+	m_End = m_Current + biggest->size;
+	m_Used = 0;
+	m_Reserved = biggest->size;
+}
+
+inline std::size_t MonotonicArena::bytesUsed() const
+{
+	return m_Used;
+}
+
+inline std::size_t MonotonicArena::bytesReserved() const
+{
+	return m_Reserved;
+}
+
+inline void MonotonicArena::addBlock(std::size_t minSize)
+{
+	std::size_t size = minSize > m_BlockSize ? minSize : m_BlockSize;
+
+	if (size > std::numeric_limits<std::size_t>::max() - headerSize)
+		throw std::bad_alloc();
+
+	Block* block = static_cast<Block*>(::operator new(headerSize + size));
+	block->next = m_Blocks;
+	block->size = size;
+
+	m_Blocks = block;
+	m_Current = blockBegin(block);
+	m_End = m_Current + size;
+	m_Reserved += size;
+}
+
+inline char* MonotonicArena::blockBegin(Block* block)
+{
+	return reinterpret_cast<char*>(block) + headerSize;
+}
+
+#endif // !ARENA_ALLOCATOR_H
@@ -0,0 +1,358 @@
+#include "Vector.h"
+#include "ConcurrentVector.h"
+#include "CompressedIntVector.h"
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cstdint>
+#include <thread>
+#include <mutex>
+#include <vector>
+
+// Same layout as Type, but not trivially copyable - forces Vector to go element by element
+template <typename Type>
+struct Wrapped
+{
+	Type value;
+
+	Wrapped() : value() {}
+	Wrapped(const Type& value) : value(value) {}
+	Wrapped(const Wrapped& other) : value(other.value) {}
+	Wrapped& operator= (const Wrapped& other) { value = other.value; return *this; }
+};
+
+struct Pod
+{
+	double x, y, z;
+	int id;
+	char tag[12];
+};
+
+template <typename Func>
+double measure(Func func, int repeats = 5)
+{
+	double best = 0;
+
+	for (int i = 0; i < repeats; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func();
+		auto end = std::chrono::steady_clock::now();
+
+		double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+
+		if (i == 0 || elapsed < best)
+			best = elapsed;
+	}
+
+	return best;
+}
+
+template <typename Type>
+double copyBench(const Vector<Type>& source)
+{
+	return measure([&]()
+	{
+		Vector<Type> copy(source);
+		volatile const Type* sink = copy.data();
+		(void)sink;
+	});
+}
+
+template <typename Type>
+double growBench(const Type& value, int count)
+{
+	return measure([&]()
+	{
+		Vector<Type> vector;
+
+		for (int i = 0; i < count; ++i)
+			vector.pushBack(value);
+	});
+}
+
+template <typename Type>
+double insertBench(const Vector<Type>& source)
+{
+	return measure([&]()
+	{
+		Vector<Type> vector;
+
+		for (int i = 0; i < 4; ++i)
+			vector.insert(source.data(), source.size());
+	});
+}
+
+template <typename Type>
+double eraseBench(const Vector<Type>& source)
+{
+	Vector<Type> vector;
+
+	return measure([&]()
+	{
+		vector = source;
+
+		for (int i = 0; i < 64; ++i)
+			vector.erase(0);
+
+		vector.erase(0, vector.size() / 2);
+	});
+}
+
+template <typename Type>
+void compare(const char* name, const Type& value, int count)
+{
+	Vector<Type> fast;
+	Vector<Wrapped<Type>> slow;
+
+	for (int i = 0; i < count; ++i)
+	{
+		fast.pushBack(value);
+		slow.pushBack(value);
+	}
+
+	auto print = [&](const char* operation, double fastTime, double slowTime)
+	{
+		std::cout << std::left << std::setw(10) << name << std::setw(10) << operation
+			<< std::right << std::fixed << std::setprecision(3)
+			<< std::setw(12) << fastTime << " ms"
+			<< std::setw(12) << slowTime << " ms"
+			<< std::setw(10) << std::setprecision(2) << slowTime / fastTime << "x\n";
+	};
+
+	print("copy", copyBench(fast), copyBench(slow));
+	print("grow", growBench(value, count), growBench(Wrapped<Type>(value), count));
+	print("insert", insertBench(fast), insertBench(slow));
+	print("erase", eraseBench(fast), eraseBench(slow));
+}
+
+struct Record
+{
+	std::uint64_t key;
+	double payload[3];
+};
+
+template <typename Type, typename Fill, typename Sort>
+double sortBench(std::size_t count, Fill fill, Sort sort)
+{
+	std::mt19937_64 random(7);
+	Vector<Type> source;
+	source.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+		source.pushBack(fill(random));
+
+	Vector<Type> vector;
+
+	// Includes the copy, which is the same for both sorts
+	return measure([&]()
+	{
+		vector = source;
+		sort(vector);
+	}, 3);
+}
+
+template <typename Type, typename Fill, typename KeyOf>
+void compareSorts(const char* name, std::size_t count, Fill fill, KeyOf keyOf)
+{
+	RadixScratch scratch;
+
+	double comparison = sortBench<Type>(count, fill, [&](Vector<Type>& vector)
+	{
+		vector.sort([&](const Type& lhs, const Type& rhs) { return keyOf(lhs) < keyOf(rhs); });
+	});
+
+	double radix = sortBench<Type>(count, fill, [&](Vector<Type>& vector)
+	{
+		vector.radixSort(keyOf, scratch);
+	});
+
+	std::cout << std::left << std::setw(10) << name
+		<< std::right << std::fixed << std::setprecision(3)
+		<< std::setw(12) << comparison << " ms"
+		<< std::setw(12) << radix << " ms"
+		<< std::setw(10) << std::setprecision(2) << comparison / radix << "x\n";
+}
+
+template <typename Push>
+double appendBench(unsigned threads, int perThread, Push push)
+{
+	return measure([&]()
+	{
+		std::vector<std::thread> workers;
+
+		for (unsigned t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t]()
+			{
+				for (int i = 0; i < perThread; ++i)
+					push(static_cast<int>(t) * perThread + i);
+			});
+		}
+
+		for (std::thread& worker : workers)
+			worker.join();
+	}, 3);
+}
+
+void compareAppends(unsigned threads, int perThread)
+{
+	double locked = 0;
+	double concurrent = 0;
+
+	{
+		Vector<int> vector;
+		std::mutex mutex;
+
+		locked = appendBench(threads, perThread, [&](int value)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			vector.pushBack(value);
+		});
+	}
+
+	{
+		ConcurrentVector<int> vector;
+
+		concurrent = appendBench(threads, perThread, [&](int value)
+		{
+			vector.pushBack(value);
+		});
+	}
+
+	std::cout << std::left << std::setw(10) << threads
+		<< std::right << std::fixed << std::setprecision(3)
+		<< std::setw(12) << locked << " ms"
+		<< std::setw(12) << concurrent << " ms"
+		<< std::setw(10) << std::setprecision(2) << locked / concurrent << "x\n";
+}
+
+void compareCompressed(const char* name, std::uint64_t maxGap, std::size_t count)
+{
+	std::mt19937_64 random(42);
+	Vector<std::uint64_t> plain;
+	CompressedIntVector compressed;
+	std::uint64_t id = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		id += 1 + random() % maxGap;
+		plain.pushBack(id);
+		compressed.pushBack(id);
+	}
+
+	volatile std::uint64_t sink = 0;
+
+	double plainScan = measure([&]()
+	{
+		std::uint64_t total = 0;
+
+		for (std::size_t i = 0; i < plain.size(); ++i)
+			total += plain[i];
+
+		sink = total;
+	});
+
+	double compressedScan = measure([&]()
+	{
+		std::uint64_t block[CompressedIntVector::BLOCK_SIZE];
+		std::uint64_t total = 0;
+
+		for (std::size_t b = 0; b < compressed.blockCount(); ++b)
+		{
+			std::size_t blockSize = compressed.decodeBlock(b, block);
+
+			for (std::size_t i = 0; i < blockSize; ++i)
+				total += block[i];
+		}
+
+		sink = total;
+	});
+
+	// The same random indices for both
+	Vector<std::size_t> indices;
+
+	for (std::size_t i = 0; i < (1 << 20); ++i)
+		indices.pushBack(static_cast<std::size_t>(random() % count));
+
+	double plainRandom = measure([&]()
+	{
+		std::uint64_t total = 0;
+
+		for (std::size_t i = 0; i < indices.size(); ++i)
+			total += plain[indices[i]];
+
+		sink = total;
+	});
+
+	double compressedRandom = measure([&]()
+	{
+		std::uint64_t total = 0;
+
+		for (std::size_t i = 0; i < indices.size(); ++i)
+			total += compressed[indices[i]];
+
+		sink = total;
+	});
+
+	std::cout << std::left << std::setw(10) << name
+		<< std::right << std::fixed << std::setprecision(2)
+		<< std::setw(12) << static_cast<double>(compressed.bytesUsed()) / count << " B"
+		<< std::setw(12) << plainScan << " ms"
+		<< std::setw(12) << compressedScan << " ms"
+		<< std::setw(12) << plainRandom << " ms"
+		<< std::setw(12) << compressedRandom << " ms\n";
+}
+
+int main()
+{
+	const int count = 1 << 20;
+
+	std::cout << "Trivially copyable fast path vs element-wise loop, " << count << " elements\n";
+	std::cout << std::left << std::setw(20) << "" << std::right << std::setw(15) << "memcpy" << std::setw(15) << "loop" << std::setw(11) << "speedup\n";
+
+	compare("int", 42, count);
+	compare("double", 4.2, count);
+	compare("Pod", Pod{ 1.0, 2.0, 3.0, 4, "pod" }, count);
+
+	const std::size_t sortCount = 1 << 24;
+
+	std::cout << "\nComparison sort vs radix sort, " << sortCount << " random elements\n";
+	std::cout << std::left << std::setw(10) << "" << std::right << std::setw(15) << "sort" << std::setw(15) << "radixSort" << std::setw(11) << "speedup\n";
+
+	compareSorts<std::uint32_t>("uint32", sortCount,
+		[](std::mt19937_64& random) { return static_cast<std::uint32_t>(random()); },
+		[](std::uint32_t value) { return value; });
+	compareSorts<std::uint64_t>("uint64", sortCount,
+		[](std::mt19937_64& random) { return static_cast<std::uint64_t>(random()); },
+		[](std::uint64_t value) { return value; });
+	compareSorts<float>("float", sortCount,
+		[](std::mt19937_64& random) { return std::uniform_real_distribution<float>(-1e6f, 1e6f)(random); },
+		[](float value) { return value; });
+	compareSorts<Record>("Record", sortCount / 4,
+		[](std::mt19937_64& random) { return Record{ random(), { 1.0, 2.0, 3.0 } }; },
+		[](const Record& record) { return record.key; });
+
+	const int appendCount = 1 << 22;
+	unsigned hardwareThreads = std::thread::hardware_concurrency();
+
+	std::cout << "\nMutex + Vector::pushBack vs ConcurrentVector::pushBack, " << appendCount << " appends split across threads\n";
+	std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(15) << "mutex" << std::setw(15) << "concurrent" << std::setw(11) << "speedup\n";
+
+	for (unsigned threads = 1; threads <= (hardwareThreads > 1 ? hardwareThreads : 1); threads *= 2)
+		compareAppends(threads, appendCount / static_cast<int>(threads));
+
+	const std::size_t idCount = 1 << 24;
+
+	std::cout << "\nCompressedIntVector vs Vector<uint64_t>, " << idCount << " sorted ids, full scan and 2^20 random reads\n";
+	std::cout << std::left << std::setw(10) << "max gap" << std::right << std::setw(15) << "bytes/id" << std::setw(15) << "plain" << std::setw(15) << "compressed"
+		<< std::setw(15) << "plain rand" << std::setw(15) << "compr. rand\n";
+
+	compareCompressed("4", 4, idCount);
+	compareCompressed("1000", 1000, idCount);
+	compareCompressed("65536", 65536, idCount);
+
+	return 0;
+}
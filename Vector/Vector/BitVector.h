@@ -0,0 +1,613 @@
+#ifndef BIT_VECTOR_H
+
+#define BIT_VECTOR_H
+
+#include "Vector.h"
+
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if !defined(VECTOR_NO_SIMD) && !defined(_MSC_VER) && (defined(__x86_64__) || defined(__i386__))
+#define BIT_VECTOR_POPCNT_DISPATCH
+#endif
+
+inline unsigned bitPopCount(std::uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	return static_cast<unsigned>(__popcnt64(word));
+#elif defined(_MSC_VER)
+	return __popcnt(static_cast<unsigned>(word)) + __popcnt(static_cast<unsigned>(word >> 32));
+#else
+	return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+}
+
+inline unsigned bitLowest(std::uint64_t word)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return index;
+#elif defined(_MSC_VER)
+	unsigned long index;
+
+	if (_BitScanForward(&index, static_cast<unsigned long>(word)))
+		return index;
+
+	_BitScanForward(&index, static_cast<unsigned long>(word >> 32));
+	return index + 32;
+#else
+	return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+// Counts the set bits in a run of words. GCC and clang only emit the popcnt instruction when told
+// the CPU has it, so on x86 there is a copy built for popcnt that is picked at runtime
+#ifdef BIT_VECTOR_POPCNT_DISPATCH
+__attribute__((target("popcnt")))
+inline std::size_t bitPopCountWordsHardware(const std::uint64_t* words, std::size_t count)
+{
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+		result += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+
+	return result;
+}
+#endif
+
+inline std::size_t bitPopCountWords(const std::uint64_t* words, std::size_t count)
+{
+#ifdef BIT_VECTOR_POPCNT_DISPATCH
+	static const bool hasPopcnt = __builtin_cpu_supports("popcnt");
+
+	if (hasPopcnt)
+		return bitPopCountWordsHardware(words, count);
+#endif
+
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < count; ++i)
+		result += bitPopCount(words[i]);
+
+	return result;
+}
+
+// Flags packed 64 to a word, for bitmaps that a Vector<bool> would spend a byte per flag on.
+// The bits past size() in the last word are always zero, so whole words can be counted and combined.
+//
+// rank / select answer from an index built by buildRankIndex(): a running count before every block
+// of 512 bits, and the block of every 4096th set bit. That costs about 13% on top of the bits.
+// Where 4096 set bits are spread over more than 2^20 bits, their positions are stored outright,
+// which costs at most another 25% of those bits. Both rank and select are then constant time:
+// select never searches more than 2048 blocks.
+// Any change to the bits makes the index stale and rank / select throw until it is rebuilt.
+class BitVector
+{
+public:
+	using size_type = std::size_t;
+	using word_type = std::uint64_t;
+
+	static const size_type WORD_BITS = 64;
+
+	BitVector();
+	explicit BitVector(size_type size, bool value = false);
+
+	bool operator[] (size_type index) const;
+	bool test(size_type index) const;
+	bool at(size_type index) const;
+
+	void set(size_type index);
+	void set(size_type index, bool value);
+	void reset(size_type index);
+	void flip(size_type index);
+
+	void setAll();
+	void resetAll();
+	void flipAll();
+
+	size_type size() const;
+	bool empty() const;
+
+	const word_type* words() const;
+	size_type wordCount() const;
+
+	void reserve(size_type newCapacity);
+	void resize(size_type newSize, bool value = false);
+	void clear();
+	void pushBack(bool value);
+	void popBack();
+
+	// The other side must be just as long, std::invalid_argument otherwise
+	BitVector& operator&= (const BitVector& other);
+	BitVector& operator|= (const BitVector& other);
+	BitVector& operator^= (const BitVector& other);
+	BitVector operator~ () const;
+
+	bool operator== (const BitVector& other) const;
+	bool operator!= (const BitVector& other) const;
+
+	// Number of set bits
+	size_type count() const;
+	bool any() const;
+	bool none() const;
+
+	void buildRankIndex();
+	bool hasRankIndex() const;
+
+	// Number of set bits before index, index can be anywhere in [0, size()]
+	size_type rank(size_type index) const;
+	// Position of the set bit with rank k (the first one has rank 0), size() if there are not that many
+	size_type select(size_type k) const;
+
+private:
+	Vector<word_type> m_Words;
+	size_type m_Size;
+
+	// m_Blocks[b] is the number of set bits before block b, with one more entry for the total
+	Vector<size_type> m_Blocks;
+	// m_Samples[j] is the block holding the set bit with rank j * SELECT_SAMPLE
+	Vector<size_type> m_Samples;
+	// For sparse samples, where in m_Positions their set bits start. NO_POSITIONS for the others
+	Vector<size_type> m_SparseStarts;
+	Vector<size_type> m_Positions;
+	bool m_Indexed;
+
+	static const size_type BLOCK_WORDS = 8;
+	static const size_type BLOCK_BITS = BLOCK_WORDS * WORD_BITS;
+	static const size_type SELECT_SAMPLE = 4096;
+	// Samples spanning more blocks than this keep their positions, so select searches at most this many
+	static const size_type SPARSE_BLOCKS = 2048;
+	static constexpr size_type NO_POSITIONS = ~size_type(0);
+
+	static size_type wordsFor(size_type bits);
+	static word_type bit(size_type index);
+	static unsigned selectInWord(word_type word, unsigned k);
+
+	word_type* wordData();
+	void clearTail();
+	void checkSize(const BitVector& other) const;
+	void checkIndex() const;
+};
+
+inline BitVector::BitVector()
+	: m_Size(0), m_Indexed(false)
+{
+}
+
+inline BitVector::BitVector(size_type size, bool value)
+	: m_Size(0), m_Indexed(false)
+{
+	resize(size, value);
+}
+
+inline bool BitVector::operator[] (size_type index) const
+{
+	return (m_Words[index / WORD_BITS] & bit(index)) != 0;
+}
+
+inline bool BitVector::test(size_type index) const
+{
+	return (*this)[index];
+}
+
+inline bool BitVector::at(size_type index) const
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return (*this)[index];
+}
+
+inline void BitVector::set(size_type index)
+{
+	m_Words[index / WORD_BITS] |= bit(index);
+	m_Indexed = false;
+}
+
+inline void BitVector::set(size_type index, bool value)
+{
+	if (value)
+		set(index);
+	else
+		reset(index);
+}
+
+inline void BitVector::reset(size_type index)
+{
+	m_Words[index / WORD_BITS] &= ~bit(index);
+	m_Indexed = false;
+}
+
+inline void BitVector::flip(size_type index)
+{
+	m_Words[index / WORD_BITS] ^= bit(index);
+	m_Indexed = false;
+}
+
+inline void BitVector::setAll()
+{
+	for (word_type& word : m_Words)
+		word = ~word_type(0);
+
+	clearTail();
+	m_Indexed = false;
+}
+
+inline void BitVector::resetAll()
+{
+	for (word_type& word : m_Words)
+		word = 0;
+
+	m_Indexed = false;
+}
+
+inline void BitVector::flipAll()
+{
+	for (word_type& word : m_Words)
+		word = ~word;
+
+	clearTail();
+	m_Indexed = false;
+}
+
+inline std::size_t BitVector::size() const
+{
+	return m_Size;
+}
+
+inline bool BitVector::empty() const
+{
+	return m_Size == 0;
+}
+
+inline const BitVector::word_type* BitVector::words() const
+{
+	return m_Words.data();
+}
+
+inline std::size_t BitVector::wordCount() const
+{
+	return m_Words.size();
+}
+
+inline void BitVector::reserve(size_type newCapacity)
+{
+	m_Words.reserve(wordsFor(newCapacity));
+}
+
+inline void BitVector::resize(size_type newSize, bool value)
+{
+	size_type oldSize = m_Size;
+
+	m_Words.resize(wordsFor(newSize), value ? ~word_type(0) : word_type(0));
+	m_Size = newSize;
+
+	// The new bits of the word that was the last one so far
+	if (value && newSize > oldSize && oldSize % WORD_BITS)
+		m_Words[oldSize / WORD_BITS] |= ~word_type(0) << (oldSize % WORD_BITS);
+
+	clearTail();
+	m_Indexed = false;
+}
+
+inline void BitVector::clear()
+{
+	m_Words.clear();
+	m_Size = 0;
+	m_Indexed = false;
+}
+
+inline void BitVector::pushBack(bool value)
+{
+	if (m_Size % WORD_BITS == 0)
+		m_Words.pushBack(0);
+
+	if (value)
+		m_Words.back() |= bit(m_Size);
+
+	++m_Size;
+	m_Indexed = false;
+}
+
+inline void BitVector::popBack()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	resize(m_Size - 1);
+}
+
+inline BitVector& BitVector::operator&= (const BitVector& other)
+{
+	checkSize(other);
+
+	word_type* words = wordData();
+
+	for (size_type i = 0; i < m_Words.size(); ++i)
+		words[i] &= other.m_Words[i];
+
+	m_Indexed = false;
+	return *this;
+}
+
+inline BitVector& BitVector::operator|= (const BitVector& other)
+{
+	checkSize(other);
+
+	word_type* words = wordData();
+
+	for (size_type i = 0; i < m_Words.size(); ++i)
+		words[i] |= other.m_Words[i];
+
+	m_Indexed = false;
+	return *this;
+}
+
+inline BitVector& BitVector::operator^= (const BitVector& other)
+{
+	checkSize(other);
+
+	word_type* words = wordData();
+
+	for (size_type i = 0; i < m_Words.size(); ++i)
+		words[i] ^= other.m_Words[i];
+
+	m_Indexed = false;
+	return *this;
+}
+
+inline BitVector BitVector::operator~ () const
+{
+	BitVector result(*this);
+	result.flipAll();
+	return result;
+}
+
+inline bool BitVector::operator== (const BitVector& other) const
+{
+	if (m_Size != other.m_Size)
+		return false;
+
+	for (size_type i = 0; i < m_Words.size(); ++i)
+	{
+		if (m_Words[i] != other.m_Words[i])
+			return false;
+	}
+
+	return true;
+}
+
+inline bool BitVector::operator!= (const BitVector& other) const
+{
+	return !(*this == other);
+}
+
+inline std::size_t BitVector::count() const
+{
+	return bitPopCountWords(m_Words.data(), m_Words.size());
+}
+
+inline bool BitVector::any() const
+{
+	for (word_type word : m_Words)
+	{
+		if (word)
+			return true;
+	}
+
+	return false;
+}
+
+inline bool BitVector::none() const
+{
+	return !any();
+}
+
+inline void BitVector::buildRankIndex()
+{
+	size_type blocks = (m_Words.size() + BLOCK_WORDS - 1) / BLOCK_WORDS;
+
+	m_Blocks.clear();
+	m_Blocks.reserve(blocks + 1);
+	m_Samples.clear();
+
+	size_type total = 0;
+
+	for (size_type b = 0; b < blocks; ++b)
+	{
+		m_Blocks.pushBack(total);
+
+		size_type first = b * BLOCK_WORDS;
+		size_type last = first + BLOCK_WORDS < m_Words.size() ? first + BLOCK_WORDS : m_Words.size();
+		size_type inBlock = bitPopCountWords(m_Words.data() + first, last - first);
+
+		// Every sampled rank that falls into this block
+		for (size_type next = m_Samples.size() * SELECT_SAMPLE; next < total + inBlock; next += SELECT_SAMPLE)
+			m_Samples.pushBack(b);
+
+		total += inBlock;
+	}
+
+	m_Blocks.pushBack(total);
+
+	m_SparseStarts.clear();
+	m_SparseStarts.reserve(m_Samples.size());
+	m_Positions.clear();
+
+	for (size_type sample = 0; sample < m_Samples.size(); ++sample)
+	{
+		size_type low = m_Samples[sample];
+		size_type high = sample + 1 < m_Samples.size() ? m_Samples[sample + 1] + 1 : blocks;
+
+		if (high - low <= SPARSE_BLOCKS)
+		{
+			m_SparseStarts.pushBack(NO_POSITIONS);
+			continue;
+		}
+
+		m_SparseStarts.pushBack(m_Positions.size());
+
+		// Walk the set bits from the start of the first block, skipping the ones of the previous sample
+		size_type skip = sample * SELECT_SAMPLE - m_Blocks[low];
+		size_type wanted = total - sample * SELECT_SAMPLE < SELECT_SAMPLE ? total - sample * SELECT_SAMPLE : SELECT_SAMPLE;
+
+		for (size_type i = low * BLOCK_WORDS; wanted > 0; ++i)
+		{
+			for (word_type word = m_Words[i]; word && wanted > 0; word &= word - 1)
+			{
+				if (skip > 0)
+				{
+					--skip;
+					continue;
+				}
+
+				m_Positions.pushBack(i * WORD_BITS + bitLowest(word));
+				--wanted;
+			}
+		}
+	}
+
+	m_Indexed = true;
+}
+
+inline bool BitVector::hasRankIndex() const
+{
+	return m_Indexed;
+}
+
+inline std::size_t BitVector::rank(size_type index) const
+{
+	checkIndex();
+
+	if (index > m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	size_type word = index / WORD_BITS;
+	size_type result = m_Blocks[word / BLOCK_WORDS];
+
+	for (size_type i = word / BLOCK_WORDS * BLOCK_WORDS; i < word; ++i)
+		result += bitPopCount(m_Words[i]);
+
+	if (index % WORD_BITS)
+		result += bitPopCount(m_Words[word] & (bit(index) - 1));
+
+	return result;
+}
+
+inline std::size_t BitVector::select(size_type k) const
+{
+	checkIndex();
+
+	if (k >= m_Blocks.back())
+		return m_Size;
+
+	size_type sample = k / SELECT_SAMPLE;
+
+	if (m_SparseStarts[sample] != NO_POSITIONS)
+		return m_Positions[m_SparseStarts[sample] + k % SELECT_SAMPLE];
+
+	// The samples narrow it down to at most SPARSE_BLOCKS blocks, a binary search over their counts finds the one
+	size_type low = m_Samples[sample];
+	size_type high = sample + 1 < m_Samples.size() ? m_Samples[sample + 1] + 1 : m_Blocks.size() - 1;
+
+	while (high - low > 1)
+	{
+		size_type middle = low + (high - low) / 2;
+
+		if (m_Blocks[middle] <= k)
+			low = middle;
+		else
+			high = middle;
+	}
+
+	size_type remaining = k - m_Blocks[low];
+
+	for (size_type i = low * BLOCK_WORDS; ; ++i)
+	{
+		unsigned inWord = bitPopCount(m_Words[i]);
+
+		if (remaining < inWord)
+			return i * WORD_BITS + selectInWord(m_Words[i], static_cast<unsigned>(remaining));
+
+		remaining -= inWord;
+	}
+}
+
+inline std::size_t BitVector::wordsFor(size_type bits)
+{
+	return (bits + WORD_BITS - 1) / WORD_BITS;
+}
+
+inline BitVector::word_type BitVector::bit(size_type index)
+{
+	return word_type(1) << (index % WORD_BITS);
+}
+
+inline unsigned BitVector::selectInWord(word_type word, unsigned k)
+{
+	// Skip whole bytes first, then single bits
+	unsigned shift = 0;
+
+	for (;; shift += 8)
+	{
+		unsigned inByte = bitPopCount((word >> shift) & 0xFF);
+
+		if (k < inByte)
+			break;
+
+		k -= inByte;
+	}
+
+	word >>= shift;
+
+	for (; k > 0; --k)
+		word &= word - 1;
+
+	return shift + bitLowest(word);
+}
+
+inline BitVector::word_type* BitVector::wordData()
+{
+	return m_Words.data();
+}
+
+inline void BitVector::clearTail()
+{
+	if (m_Size % WORD_BITS)
+		m_Words.back() &= bit(m_Size) - 1;
+}
+
+inline void BitVector::checkSize(const BitVector& other) const
+{
+	if (m_Size != other.m_Size)
+		throw std::invalid_argument("The bit vectors have different sizes!");
+}
+
+inline void BitVector::checkIndex() const
+{
+	if (!m_Indexed)
+		throw std::logic_error("The rank index is out of date, call buildRankIndex first!");
+}
+
+inline BitVector operator& (BitVector lhs, const BitVector& rhs)
+{
+	return lhs &= rhs;
+}
+
+inline BitVector operator| (BitVector lhs, const BitVector& rhs)
+{
+	return lhs |= rhs;
+}
+
+inline BitVector operator^ (BitVector lhs, const BitVector& rhs)
+{
+	return lhs ^= rhs;
+}
+
+#endif // !BIT_VECTOR_H
@@ -0,0 +1,314 @@
+#ifndef COMPRESSED_INT_VECTOR_H
+
+#define COMPRESSED_INT_VECTOR_H
+
+#include "Vector.h"
+
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Unpacks BLOCK_SIZE values of Width bits each. With the width known at compile time every shift and mask
+// is a constant and the loop has no branches, so the compiler unrolls and vectorizes it
+template <unsigned Width>
+struct BitUnpacker
+{
+	template <std::size_t Count>
+	static void unpack(const std::uint64_t* in, std::uint64_t* out)
+	{
+		const std::uint64_t mask = Width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << (Width % 64)) - 1;
+
+		for (std::size_t i = 0; i < Count; ++i)
+		{
+			std::size_t bit = i * Width;
+			std::size_t word = bit / 64;
+			unsigned shift = bit % 64;
+
+			std::uint64_t value = in[word] >> shift;
+
+			if (shift + Width > 64)
+				value |= in[word + 1] << (64 - shift);
+
+			out[i] = value & mask;
+		}
+	}
+};
+
+template <>
+struct BitUnpacker<0>
+{
+	template <std::size_t Count>
+	static void unpack(const std::uint64_t*, std::uint64_t* out)
+	{
+		for (std::size_t i = 0; i < Count; ++i)
+			out[i] = 0;
+	}
+};
+
+// Integers stored in blocks of BLOCK_SIZE. A block keeps its first value in a skip entry and the rest
+// as differences to the value before, all packed with the bit width of the biggest difference.
+// Sorted ids with small gaps take a few bits each instead of 64. Unsorted values still work,
+// their differences just wrap around and need more bits.
+//
+// Random access goes to the block through its skip entry. The entry also keeps every ANCHOR_STEP-th value,
+// so at most ANCHOR_STEP - 1 differences are added up from the closest one before the index.
+// The last, unfinished block is kept plain until it fills up, so appending is cheap.
+class CompressedIntVector
+{
+public:
+	using value_type = std::uint64_t;
+	using size_type = std::size_t;
+
+	static const size_type BLOCK_SIZE = 128;
+	// A plain value every ANCHOR_STEP values, a quarter byte per value for sorted ids
+	static const size_type ANCHOR_STEP = 32;
+
+	CompressedIntVector();
+	CompressedIntVector(const std::uint64_t* data, size_type dataSize);
+
+	std::uint64_t operator[] (size_type index) const;
+	std::uint64_t at(size_type index) const;
+
+	size_type size() const;
+	bool empty() const;
+	// Bytes taken by the packed data, the skip entries and the unfinished block
+	size_type bytesUsed() const;
+
+	void clear();
+	void pushBack(std::uint64_t value);
+	void insert(const std::uint64_t* data, size_type dataSize);
+
+	// Blocks, the unfinished one included
+	size_type blockCount() const;
+	// Writes the values of a block to out, which needs room for BLOCK_SIZE of them, and returns how many there were
+	size_type decodeBlock(size_type block, std::uint64_t* out) const;
+	Vector<std::uint64_t> toVector() const;
+
+private:
+	struct SkipEntry
+	{
+		// The values at offsets 0, ANCHOR_STEP, 2 * ANCHOR_STEP and so on
+		std::uint64_t anchors[BLOCK_SIZE / ANCHOR_STEP];
+		size_type wordOffset;
+		unsigned width;
+	};
+
+	Vector<std::uint64_t> m_Words;
+	Vector<SkipEntry> m_Skips;
+	Vector<std::uint64_t> m_Tail;
+	size_type m_Size;
+
+	void packTail();
+	std::uint64_t valueInBlock(const SkipEntry& entry, size_type offset) const;
+
+	static unsigned bitWidth(std::uint64_t value);
+	static void unpack(unsigned width, const std::uint64_t* in, std::uint64_t* out);
+
+	template <std::size_t... Widths>
+	static void unpackWith(unsigned width, const std::uint64_t* in, std::uint64_t* out, std::index_sequence<Widths...>);
+};
+
+inline CompressedIntVector::CompressedIntVector()
+	: m_Size(0)
+{
+}
+
+inline CompressedIntVector::CompressedIntVector(const std::uint64_t* data, size_type dataSize)
+	: m_Size(0)
+{
+	insert(data, dataSize);
+}
+
+inline std::uint64_t CompressedIntVector::operator[] (size_type index) const
+{
+	size_type block = index / BLOCK_SIZE;
+
+	if (block == m_Skips.size())
+		return m_Tail[index % BLOCK_SIZE];
+
+	return valueInBlock(m_Skips[block], index % BLOCK_SIZE);
+}
+
+inline std::uint64_t CompressedIntVector::at(size_type index) const
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return (*this)[index];
+}
+
+inline std::size_t CompressedIntVector::size() const
+{
+	return m_Size;
+}
+
+inline bool CompressedIntVector::empty() const
+{
+	return m_Size == 0;
+}
+
+inline std::size_t CompressedIntVector::bytesUsed() const
+{
+	return m_Words.size() * sizeof(std::uint64_t) + m_Skips.size() * sizeof(SkipEntry) + m_Tail.size() * sizeof(std::uint64_t);
+}
+
+inline void CompressedIntVector::clear()
+{
+	m_Words.clear();
+	m_Skips.clear();
+	m_Tail.clear();
+	m_Size = 0;
+}
+
+inline void CompressedIntVector::pushBack(std::uint64_t value)
+{
+	m_Tail.pushBack(value);
+	++m_Size;
+
+	if (m_Tail.size() == BLOCK_SIZE)
+		packTail();
+}
+
+inline void CompressedIntVector::insert(const std::uint64_t* data, size_type dataSize)
+{
+	for (size_type i = 0; i < dataSize; ++i)
+		pushBack(data[i]);
+}
+
+inline std::size_t CompressedIntVector::blockCount() const
+{
+	return m_Skips.size() + (m_Tail.empty() ? 0 : 1);
+}
+
+inline std::size_t CompressedIntVector::decodeBlock(size_type block, std::uint64_t* out) const
+{
+	if (block >= blockCount())
+		throw std::out_of_range("Block is out of range!");
+
+	if (block == m_Skips.size())
+	{
+		for (size_type i = 0; i < m_Tail.size(); ++i)
+			out[i] = m_Tail[i];
+
+		return m_Tail.size();
+	}
+
+	const SkipEntry& entry = m_Skips[block];
+	unpack(entry.width, m_Words.data() + entry.wordOffset, out);
+
+	// The differences turn back into values with a running sum
+	out[0] = entry.anchors[0];
+
+	for (size_type i = 1; i < BLOCK_SIZE; ++i)
+		out[i] += out[i - 1];
+
+	return BLOCK_SIZE;
+}
+
+inline Vector<std::uint64_t> CompressedIntVector::toVector() const
+{
+	Vector<std::uint64_t> result;
+	result.resize(m_Size);
+
+	std::uint64_t* out = result.data();
+
+	for (size_type block = 0; block < blockCount(); ++block)
+		out += decodeBlock(block, out);
+
+	return result;
+}
+
+inline void CompressedIntVector::packTail()
+{
+	// The first difference is always zero, the value itself goes to the skip entry
+	std::uint64_t differences[BLOCK_SIZE];
+	std::uint64_t biggest = 0;
+
+	differences[0] = 0;
+
+	for (size_type i = 1; i < BLOCK_SIZE; ++i)
+	{
+		differences[i] = m_Tail[i] - m_Tail[i - 1];
+		biggest |= differences[i];
+	}
+
+	SkipEntry entry;
+
+	for (size_type i = 0; i < BLOCK_SIZE / ANCHOR_STEP; ++i)
+		entry.anchors[i] = m_Tail[i * ANCHOR_STEP];
+
+	entry.wordOffset = m_Words.size();
+	entry.width = bitWidth(biggest);
+
+	// BLOCK_SIZE * width bits is always a whole number of words, so every block starts on a word
+	m_Words.resize(m_Words.size() + BLOCK_SIZE * entry.width / 64);
+	std::uint64_t* words = m_Words.data() + entry.wordOffset;
+
+	for (size_type i = 0; i < BLOCK_SIZE && entry.width > 0; ++i)
+	{
+		size_type bit = i * entry.width;
+		size_type word = bit / 64;
+		unsigned shift = bit % 64;
+
+		words[word] |= differences[i] << shift;
+
+		if (shift + entry.width > 64)
+			words[word + 1] |= differences[i] >> (64 - shift);
+	}
+
+	m_Skips.pushBack(entry);
+	m_Tail.clear();
+}
+
+inline std::uint64_t CompressedIntVector::valueInBlock(const SkipEntry& entry, size_type offset) const
+{
+	const std::uint64_t* words = m_Words.data() + entry.wordOffset;
+	const std::uint64_t mask = entry.width == 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << entry.width) - 1;
+
+	size_type anchor = offset / ANCHOR_STEP;
+	std::uint64_t value = entry.anchors[anchor];
+
+	for (size_type i = anchor * ANCHOR_STEP + 1; i <= offset && entry.width > 0; ++i)
+	{
+		size_type bit = i * entry.width;
+		size_type word = bit / 64;
+		unsigned shift = bit % 64;
+
+		std::uint64_t difference = words[word] >> shift;
+
+		if (shift + entry.width > 64)
+			difference |= words[word + 1] << (64 - shift);
+
+		value += difference & mask;
+	}
+
+	return value;
+}
+
+inline unsigned CompressedIntVector::bitWidth(std::uint64_t value)
+{
+	unsigned width = 0;
+
+	for (; value; value >>= 1)
+		++width;
+
+	return width;
+}
+
+inline void CompressedIntVector::unpack(unsigned width, const std::uint64_t* in, std::uint64_t* out)
+{
+	unpackWith(width, in, out, std::make_index_sequence<65>());
+}
+
+template <std::size_t... Widths>
+inline void CompressedIntVector::unpackWith(unsigned width, const std::uint64_t* in, std::uint64_t* out, std::index_sequence<Widths...>)
+{
+	// One unrolled unpacker per width, picked through a table
+	using Unpack = void (*)(const std::uint64_t*, std::uint64_t*);
+	static const Unpack unpackers[] = { &BitUnpacker<Widths>::template unpack<BLOCK_SIZE>... };
+
+	unpackers[width](in, out);
+}
+
+#endif // !COMPRESSED_INT_VECTOR_H
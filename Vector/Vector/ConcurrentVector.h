@@ -0,0 +1,296 @@
+#ifndef CONCURRENT_VECTOR_H
+
+#define CONCURRENT_VECTOR_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+#include <new>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// An append-only vector that any number of threads can push into at the same time, without a lock.
+// A push claims its index with one atomic add and constructs the element in a bucket. Bucket b holds
+// FIRST_BUCKET_SIZE << b elements and buckets are never moved or freed before the vector is,
+// so the address of an element never changes.
+//
+// An element can be read once it is published, i.e. its pushBack returned in some thread.
+// isPublished / at check that; operator[] is for indices the caller already knows are published.
+template <typename Type>
+class ConcurrentVector
+{
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using reference = Type&;
+	using const_reference = const Type&;
+
+	ConcurrentVector();
+	ConcurrentVector(const ConcurrentVector& other) = delete;
+	~ConcurrentVector();
+
+	ConcurrentVector& operator= (const ConcurrentVector& other) = delete;
+
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
+
+	// Throws std::out_of_range unless the element is published
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
+
+	bool isPublished(size_type index) const;
+
+	// The number of claimed indices, the latest ones may still be under construction
+	size_type size() const;
+	bool empty() const;
+
+	// Allocates the buckets up front, so pushes below newCapacity never allocate
+	void reserve(size_type newCapacity);
+
+	// All of these return the index of the new element.
+	// If the constructor throws, the claimed index stays unpublished for good
+	size_type pushBack(const Type& el);
+	size_type pushBack(Type&& el);
+	template <typename... Args>
+	size_type emplaceBack(Args&&... args);
+
+private:
+	static const size_type FIRST_BUCKET_BITS = 5;
+	static const size_type FIRST_BUCKET_SIZE = size_type(1) << FIRST_BUCKET_BITS;
+
+	// Enough buckets to hold every index a size_type can have
+	static const size_type BUCKET_COUNT = sizeof(size_type) * 8 - FIRST_BUCKET_BITS;
+
+	// A bucket is its elements followed by one ready flag per element
+	struct Bucket
+	{
+		Type* elements;
+		std::atomic<bool>* ready;
+	};
+
+	std::atomic<unsigned char*> m_Buckets[BUCKET_COUNT];
+	std::atomic<size_type> m_Size;
+
+	static size_type bucketOf(size_type index);
+	static size_type bucketSize(size_type bucket);
+	static size_type offsetOf(size_type index, size_type bucket);
+	static size_type highestBit(size_type value);
+
+	static Bucket view(unsigned char* memory, size_type bucket);
+	unsigned char* bucket(size_type bucket);
+	unsigned char* allocateBucket(size_type bucket);
+	static void deallocateBucket(unsigned char* memory);
+};
+
+template<typename Type>
+inline ConcurrentVector<Type>::ConcurrentVector()
+	: m_Size(0)
+{
+	for (size_type i = 0; i < BUCKET_COUNT; ++i)
+		m_Buckets[i].store(nullptr, std::memory_order_relaxed);
+}
+
+template<typename Type>
+inline ConcurrentVector<Type>::~ConcurrentVector()
+{
+	for (size_type i = 0; i < BUCKET_COUNT; ++i)
+	{
+		unsigned char* memory = m_Buckets[i].load(std::memory_order_acquire);
+
+		if (!memory)
+			continue;
+
+		Bucket current = view(memory, i);
+
+		for (size_type j = 0; j < bucketSize(i); ++j)
+		{
+			if (current.ready[j].load(std::memory_order_relaxed))
+				current.elements[j].~Type();
+		}
+
+		deallocateBucket(memory);
+	}
+}
+
+template<typename Type>
+inline Type& ConcurrentVector<Type>::operator[] (size_type index)
+{
+	size_type bucket = bucketOf(index);
+	return view(m_Buckets[bucket].load(std::memory_order_acquire), bucket).elements[offsetOf(index, bucket)];
+}
+
+template<typename Type>
+inline const Type& ConcurrentVector<Type>::operator[] (size_type index) const
+{
+	size_type bucket = bucketOf(index);
+	return view(m_Buckets[bucket].load(std::memory_order_acquire), bucket).elements[offsetOf(index, bucket)];
+}
+
+template<typename Type>
+inline Type& ConcurrentVector<Type>::at(size_type index)
+{
+	if (!isPublished(index))
+		throw std::out_of_range("Index is out of range!");
+
+	return (*this)[index];
+}
+
+template<typename Type>
+inline const Type& ConcurrentVector<Type>::at(size_type index) const
+{
+	if (!isPublished(index))
+		throw std::out_of_range("Index is out of range!");
+
+	return (*this)[index];
+}
+
+template<typename Type>
+inline bool ConcurrentVector<Type>::isPublished(size_type index) const
+{
+	if (index >= size())
+		return false;
+
+	size_type bucket = bucketOf(index);
+	unsigned char* memory = m_Buckets[bucket].load(std::memory_order_acquire);
+
+	// Pairs with the release in emplaceBack, so the element is fully visible after this
+	return memory && view(memory, bucket).ready[offsetOf(index, bucket)].load(std::memory_order_acquire);
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::size() const
+{
+	return m_Size.load(std::memory_order_acquire);
+}
+
+template<typename Type>
+inline bool ConcurrentVector<Type>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename Type>
+inline void ConcurrentVector<Type>::reserve(size_type newCapacity)
+{
+	if (newCapacity == 0)
+		return;
+
+	for (size_type i = 0; i <= bucketOf(newCapacity - 1); ++i)
+		bucket(i);
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::pushBack(const Type& el)
+{
+	return emplaceBack(el);
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::pushBack(Type&& el)
+{
+	return emplaceBack(std::move(el));
+}
+
+template<typename Type>
+template<typename... Args>
+inline std::size_t ConcurrentVector<Type>::emplaceBack(Args&&... args)
+{
+	size_type index = m_Size.fetch_add(1, std::memory_order_relaxed);
+	size_type bucketIndex = bucketOf(index);
+	size_type offset = offsetOf(index, bucketIndex);
+
+	Bucket current = view(bucket(bucketIndex), bucketIndex);
+
+	new (current.elements + offset) Type(std::forward<Args>(args)...);
+	current.ready[offset].store(true, std::memory_order_release);
+
+	return index;
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::bucketOf(size_type index)
+{
+	return highestBit(index + FIRST_BUCKET_SIZE) - FIRST_BUCKET_BITS;
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::bucketSize(size_type bucket)
+{
+	return FIRST_BUCKET_SIZE << bucket;
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::offsetOf(size_type index, size_type bucket)
+{
+	// Bucket b starts at index FIRST_BUCKET_SIZE * (2^b - 1)
+	return index + FIRST_BUCKET_SIZE - bucketSize(bucket);
+}
+
+template<typename Type>
+inline std::size_t ConcurrentVector<Type>::highestBit(size_type value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	unsigned long bit;
+	_BitScanReverse64(&bit, value);
+	return bit;
+#elif defined(_MSC_VER)
+	unsigned long bit;
+	_BitScanReverse(&bit, value);
+	return bit;
+#else
+	return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(value);
+#endif
+}
+
+template<typename Type>
+inline typename ConcurrentVector<Type>::Bucket ConcurrentVector<Type>::view(unsigned char* memory, size_type bucket)
+{
+	Bucket result;
+	result.elements = reinterpret_cast<Type*>(memory);
+	result.ready = reinterpret_cast<std::atomic<bool>*>(memory + bucketSize(bucket) * sizeof(Type));
+	return result;
+}
+
+template<typename Type>
+inline unsigned char* ConcurrentVector<Type>::bucket(size_type bucket)
+{
+	unsigned char* memory = m_Buckets[bucket].load(std::memory_order_acquire);
+
+	if (memory)
+		return memory;
+
+	// Several threads may get here for the same bucket. All of them allocate one,
+	// the first to get it in wins and the others throw theirs away
+	unsigned char* fresh = allocateBucket(bucket);
+
+	if (m_Buckets[bucket].compare_exchange_strong(memory, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+		return fresh;
+
+	deallocateBucket(fresh);
+	return memory;
+}
+
+template<typename Type>
+inline unsigned char* ConcurrentVector<Type>::allocateBucket(size_type bucket)
+{
+	size_type size = bucketSize(bucket);
+	unsigned char* memory = static_cast<unsigned char*>(::operator new(size * (sizeof(Type) + sizeof(std::atomic<bool>)), std::align_val_t(alignof(Type))));
+
+	std::atomic<bool>* ready = view(memory, bucket).ready;
+
+	for (size_type i = 0; i < size; ++i)
+		new (ready + i) std::atomic<bool>(false);
+
+	return memory;
+}
+
+template<typename Type>
+inline void ConcurrentVector<Type>::deallocateBucket(unsigned char* memory)
+{
+	::operator delete(memory, std::align_val_t(alignof(Type)));
+}
+
+#endif // !CONCURRENT_VECTOR_H
@@ -0,0 +1,66 @@
+#ifndef GROWTH_POLICY_H
+
+#define GROWTH_POLICY_H
+
+#include <cstddef>
+#include <limits>
+
+// A growth policy decides how big the new buffer should be once the vector runs out of space.
+// nextCapacity is only called when required > capacity and must return at least required.
+
+// Multiplies the capacity by Numerator / Denominator (1.5x by default) so pushBack is amortized O(1)
+template <std::size_t Numerator = 3, std::size_t Denominator = 2>
+struct GeometricGrowth
+{
+	static_assert(Numerator > Denominator && Denominator > 0, "The growth factor must be bigger than 1!");
+
+	static std::size_t nextCapacity(std::size_t capacity, std::size_t required)
+	{
+		std::size_t step = capacity / Denominator * (Numerator - Denominator);
+
+		// Near the end of the address space just give what was asked for
+		if (step > std::numeric_limits<std::size_t>::max() - capacity)
+			return required;
+
+		std::size_t grown = capacity + step;
+		std::size_t newCapacity = grown > required ? grown : required;
+
+		return newCapacity < 4 ? 4 : newCapacity;
+	}
+};
+
+using DoublingGrowth = GeometricGrowth<2, 1>;
+
+// Grows in fixed steps like the vector used to. Cheap on memory, but filling it up is quadratic
+template <std::size_t Step = 16>
+struct FixedStepGrowth
+{
+	static_assert(Step > 0, "The step must be positive!");
+
+	static std::size_t nextCapacity(std::size_t /* capacity */, std::size_t required)
+	{
+		std::size_t steps = required / Step + 1;
+
+		// The next step would not fit in a size_t, so just take what is needed
+		if (steps > std::numeric_limits<std::size_t>::max() / Step)
+			return required;
+
+		return steps * Step;
+	}
+};
+
+// Rounds the capacity up to the next power of two
+struct PowerOfTwoGrowth
+{
+	static std::size_t nextCapacity(std::size_t /* capacity */, std::size_t required)
+	{
+		std::size_t newCapacity = 4;
+
+		while (newCapacity < required && newCapacity <= std::numeric_limits<std::size_t>::max() / 2)
+			newCapacity *= 2;
+
+		return newCapacity < required ? required : newCapacity;
+	}
+};
+
+#endif // !GROWTH_POLICY_H
@@ -0,0 +1,40 @@
+#ifndef INLINE_STORAGE_H
+
+#define INLINE_STORAGE_H
+
+#include <cstddef>
+
+// Raw, uninitialized room for Capacity elements that lives inside the owning object.
+// Vector inherits from it, so with Capacity = 0 it takes no space at all.
+template <typename Type, std::size_t Capacity>
+struct InlineStorage
+{
+	Type* inlineData()
+	{
+		return reinterpret_cast<Type*>(m_Buffer);
+	}
+
+	const Type* inlineData() const
+	{
+		return reinterpret_cast<const Type*>(m_Buffer);
+	}
+
+private:
+	alignas(Type) unsigned char m_Buffer[sizeof(Type) * Capacity];
+};
+
+template <typename Type>
+struct InlineStorage<Type, 0>
+{
+	Type* inlineData()
+	{
+		return nullptr;
+	}
+
+	const Type* inlineData() const
+	{
+		return nullptr;
+	}
+};
+
+#endif // !INLINE_STORAGE_H
@@ -0,0 +1,512 @@
+#ifndef MAPPED_VECTOR_H
+
+#define MAPPED_VECTOR_H
+
+#include "GrowthPolicy.h"
+#include "VectorFormat.h"
+
+#include <type_traits>
+#include <system_error>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+// A vector of trivially copyable elements that lives in a memory-mapped file.
+// The file is in the VectorFormat.h layout, with the size in the header, so opening an existing file
+// only maps it and nothing is parsed or copied. A VectorView can read it too. The OS pages the elements in and out,
+// so the data can be bigger than the RAM.
+//
+// An existing file is mapped at the size it has and only grows once more room is needed.
+// Growing remaps the file, which invalidates pointers and references, just like in Vector.
+template <typename Type, typename GrowthPolicy = GeometricGrowth<>>
+class MappedVector
+{
+	static_assert(std::is_trivially_copyable<Type>::value, "MappedVector stores the elements as raw bytes");
+	static_assert(alignof(Type) <= VECTOR_FORMAT_DATA_OFFSET, "The elements would not be aligned in the mapping");
+
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using reference = Type&;
+	using const_reference = const Type&;
+	using pointer = Type*;
+	using const_pointer = const Type*;
+
+	// Opens the file, or creates it when it does not exist.
+	// Throws std::runtime_error when the file is not in the VectorFormat.h layout or holds a different element size
+	explicit MappedVector(const char* path);
+	MappedVector(const MappedVector& other) = delete;
+	MappedVector(MappedVector&& other) noexcept;
+	~MappedVector();
+
+	MappedVector& operator= (const MappedVector& other) = delete;
+	MappedVector& operator= (MappedVector&& other) noexcept;
+
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
+
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
+
+	Type& back();
+	const Type& back() const;
+	Type& front();
+	const Type& front() const;
+
+	Type* data();
+	const Type* data() const;
+
+	std::size_t size() const;
+	std::size_t capacity() const;
+	bool empty() const;
+
+	// std::length_error when newCapacity does not fit in a file
+	void reserve(size_type newCapacity);
+	void clear();
+	void insert(const Type* data, size_type dataSize);
+	void pushBack(const Type& el);
+	void popBack();
+
+	// Blocks until everything written so far, the size included, is on the disk
+	void sync();
+
+private:
+	// The file grows in steps of this many bytes, so small appends do not remap every time
+	static const std::size_t MAPPING_GRANULARITY = 1 << 16;
+
+	unsigned char* m_Mapping;
+	std::size_t m_MappingSize;
+	Type* m_Data;
+	std::size_t m_Capacity;
+
+#ifdef _WIN32
+	HANDLE m_File;
+	HANDLE m_MappingHandle;
+#else
+	int m_File;
+#endif
+
+	VectorFileHeader* header() const;
+	// Maps the first bytes of the file, growing it when it is shorter. The new mapping is made
+	// before the old one is dropped, so a failure leaves the vector as it was
+	void map(std::size_t bytes);
+	void unmap();
+	void close();
+	void steal(MappedVector& other);
+
+	[[noreturn]] static void fail(const char* message);
+};
+
+template<typename Type, typename GrowthPolicy>
+inline MappedVector<Type, GrowthPolicy>::MappedVector(const char* path)
+	: m_Mapping(nullptr), m_MappingSize(0), m_Data(nullptr), m_Capacity(0)
+{
+	std::size_t fileSize;
+
+#ifdef _WIN32
+	m_MappingHandle = nullptr;
+	m_File = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (m_File == INVALID_HANDLE_VALUE)
+		fail("Could not open the file!");
+
+	LARGE_INTEGER size;
+
+	if (!GetFileSizeEx(m_File, &size))
+	{
+		CloseHandle(m_File);
+		fail("Could not read the file size!");
+	}
+
+	fileSize = static_cast<std::size_t>(size.QuadPart);
+#else
+	m_File = ::open(path, O_RDWR | O_CREAT, 0644);
+
+	if (m_File < 0)
+		fail("Could not open the file!");
+
+	struct stat status;
+
+	if (::fstat(m_File, &status) != 0)
+	{
+		int error = errno;
+		::close(m_File);
+		throw std::system_error(error, std::generic_category(), "Could not read the file size!");
+	}
+
+	fileSize = static_cast<std::size_t>(status.st_size);
+#endif
+
+	try
+	{
+		if (fileSize == 0)
+		{
+			map(MAPPING_GRANULARITY);
+
+			*header() = makeVectorFileHeader(sizeof(Type), 0);
+		}
+		else
+		{
+			if (fileSize < VECTOR_FORMAT_DATA_OFFSET)
+				throw std::runtime_error("The data is not a serialized vector!");
+
+			map(fileSize);
+			checkVectorFileHeader(*header(), sizeof(Type));
+
+			if (header()->size > m_Capacity)
+				throw std::runtime_error("The file is shorter than its size says!");
+		}
+	}
+	catch (...)
+	{
+		close();
+		throw;
+	}
+}
+
+template<typename Type, typename GrowthPolicy>
+inline MappedVector<Type, GrowthPolicy>::MappedVector(MappedVector&& other) noexcept
+{
+	steal(other);
+}
+
+template<typename Type, typename GrowthPolicy>
+inline MappedVector<Type, GrowthPolicy>::~MappedVector()
+{
+	close();
+}
+
+template<typename Type, typename GrowthPolicy>
+inline MappedVector<Type, GrowthPolicy>& MappedVector<Type, GrowthPolicy>::operator= (MappedVector&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+		steal(other);
+	}
+
+	return *this;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline Type& MappedVector<Type, GrowthPolicy>::operator[] (size_type index)
+{
+	return m_Data[index];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline const Type& MappedVector<Type, GrowthPolicy>::operator[] (size_type index) const
+{
+	return m_Data[index];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline Type& MappedVector<Type, GrowthPolicy>::at(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	return m_Data[index];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline const Type& MappedVector<Type, GrowthPolicy>::at(size_type index) const
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	return m_Data[index];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline Type& MappedVector<Type, GrowthPolicy>::back()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[size() - 1];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline const Type& MappedVector<Type, GrowthPolicy>::back() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[size() - 1];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline Type& MappedVector<Type, GrowthPolicy>::front()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[0];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline const Type& MappedVector<Type, GrowthPolicy>::front() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[0];
+}
+
+template<typename Type, typename GrowthPolicy>
+inline Type* MappedVector<Type, GrowthPolicy>::data()
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline const Type* MappedVector<Type, GrowthPolicy>::data() const
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline std::size_t MappedVector<Type, GrowthPolicy>::size() const
+{
+	return m_Mapping ? static_cast<std::size_t>(header()->size) : 0;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline std::size_t MappedVector<Type, GrowthPolicy>::capacity() const
+{
+	return m_Capacity;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline bool MappedVector<Type, GrowthPolicy>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::reserve(size_type newCapacity)
+{
+	if (newCapacity <= m_Capacity)
+		return;
+
+	if (newCapacity > (std::numeric_limits<std::size_t>::max() - VECTOR_FORMAT_DATA_OFFSET - MAPPING_GRANULARITY) / sizeof(Type))
+		throw std::length_error("The capacity is too big for a vector!");
+
+	std::size_t bytes = VECTOR_FORMAT_DATA_OFFSET + newCapacity * sizeof(Type);
+	map((bytes + MAPPING_GRANULARITY - 1) / MAPPING_GRANULARITY * MAPPING_GRANULARITY);
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::clear()
+{
+	header()->size = 0;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::insert(const Type* data, size_type dataSize)
+{
+	std::size_t oldSize = size();
+	std::size_t newSize = oldSize + dataSize;
+
+	if (newSize > m_Capacity)
+	{
+		// The source may be inside the mapping that is about to move
+		if (data >= m_Data && data < m_Data + oldSize)
+		{
+			std::size_t offset = data - m_Data;
+			reserve(GrowthPolicy::nextCapacity(m_Capacity, newSize));
+			data = m_Data + offset;
+		}
+		else
+			reserve(GrowthPolicy::nextCapacity(m_Capacity, newSize));
+	}
+
+	if (dataSize > 0)
+		std::memmove(m_Data + oldSize, data, dataSize * sizeof(Type));
+
+	header()->size = newSize;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::pushBack(const Type& el)
+{
+	std::size_t oldSize = size();
+
+	if (oldSize == m_Capacity)
+	{
+		Type copy = el;
+		reserve(GrowthPolicy::nextCapacity(m_Capacity, oldSize + 1));
+		m_Data[oldSize] = copy;
+	}
+	else
+		m_Data[oldSize] = el;
+
+	header()->size = oldSize + 1;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::popBack()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	--header()->size;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::sync()
+{
+	std::size_t bytes = VECTOR_FORMAT_DATA_OFFSET + size() * sizeof(Type);
+
+#ifdef _WIN32
+	if (!FlushViewOfFile(m_Mapping, bytes) || !FlushFileBuffers(m_File))
+		fail("Could not sync the file!");
+#else
+	if (::msync(m_Mapping, bytes, MS_SYNC) != 0)
+		fail("Could not sync the file!");
+#endif
+}
+
+template<typename Type, typename GrowthPolicy>
+inline VectorFileHeader* MappedVector<Type, GrowthPolicy>::header() const
+{
+	return reinterpret_cast<VectorFileHeader*>(m_Mapping);
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::map(std::size_t bytes)
+{
+#ifdef _WIN32
+	// A mapping bigger than the file grows the file
+	HANDLE mappingHandle = CreateFileMappingA(m_File, nullptr, PAGE_READWRITE,
+		static_cast<DWORD>(static_cast<std::uint64_t>(bytes) >> 32), static_cast<DWORD>(bytes), nullptr);
+
+	if (!mappingHandle)
+		fail("Could not map the file!");
+
+	void* mapping = MapViewOfFile(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+
+	if (!mapping)
+	{
+		DWORD error = GetLastError();
+		CloseHandle(mappingHandle);
+		throw std::system_error(static_cast<int>(error), std::system_category(), "Could not map the file!");
+	}
+#else
+	struct stat status;
+
+	if (::fstat(m_File, &status) != 0)
+		fail("Could not read the file size!");
+
+	if (static_cast<std::size_t>(status.st_size) < bytes && ::ftruncate(m_File, static_cast<off_t>(bytes)) != 0)
+		fail("Could not grow the file!");
+
+	void* mapping = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, m_File, 0);
+
+	if (mapping == MAP_FAILED)
+		fail("Could not map the file!");
+#endif
+
+	unmap();
+
+#ifdef _WIN32
+	m_MappingHandle = mappingHandle;
+#endif
+
+	m_Mapping = static_cast<unsigned char*>(mapping);
+	m_MappingSize = bytes;
+	m_Data = reinterpret_cast<Type*>(m_Mapping + VECTOR_FORMAT_DATA_OFFSET);
+	m_Capacity = (bytes - VECTOR_FORMAT_DATA_OFFSET) / sizeof(Type);
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::unmap()
+{
+	if (!m_Mapping)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(m_Mapping);
+	CloseHandle(m_MappingHandle);
+	m_MappingHandle = nullptr;
+#else
+	::munmap(m_Mapping, m_MappingSize);
+#endif
+
+	m_Mapping = nullptr;
+	m_MappingSize = 0;
+	m_Data = nullptr;
+	m_Capacity = 0;
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::close()
+{
+	unmap();
+
+#ifdef _WIN32
+	if (m_File != INVALID_HANDLE_VALUE)
+		CloseHandle(m_File);
+
+	m_File = INVALID_HANDLE_VALUE;
+#else
+	if (m_File >= 0)
+		::close(m_File);
+
+	m_File = -1;
+#endif
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::steal(MappedVector& other)
+{
+	m_Mapping = other.m_Mapping;
+	m_MappingSize = other.m_MappingSize;
+	m_Data = other.m_Data;
+	m_Capacity = other.m_Capacity;
+	m_File = other.m_File;
+
+	other.m_Mapping = nullptr;
+	other.m_MappingSize = 0;
+	other.m_Data = nullptr;
+	other.m_Capacity = 0;
+
+#ifdef _WIN32
+	m_MappingHandle = other.m_MappingHandle;
+	other.m_MappingHandle = nullptr;
+	other.m_File = INVALID_HANDLE_VALUE;
+#else
+	other.m_File = -1;
+#endif
+}
+
+template<typename Type, typename GrowthPolicy>
+inline void MappedVector<Type, GrowthPolicy>::fail(const char* message)
+{
+#ifdef _WIN32
+	throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), message);
+#else
+	throw std::system_error(errno, std::generic_category(), message);
+#endif
+}
+
+#endif // !MAPPED_VECTOR_H
@@ -0,0 +1,192 @@
+#ifndef RADIX_SORT_H
+
+#define RADIX_SORT_H
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+// LSD radix sort over plain arrays, used by Vector::radixSort.
+// Keys are turned into unsigned integers that sort the same way and then sorted one byte at a time,
+// so the cost is one pass per key byte no matter how the input looks.
+
+template <std::size_t Bytes>
+struct RadixBits;
+
+template <> struct RadixBits<1> { using Type = std::uint8_t; };
+template <> struct RadixBits<2> { using Type = std::uint16_t; };
+template <> struct RadixBits<4> { using Type = std::uint32_t; };
+template <> struct RadixBits<8> { using Type = std::uint64_t; };
+
+// Maps a key to unsigned bits with the same order
+template <typename Key, typename Enable = void>
+struct RadixKey;
+
+template <typename Key>
+struct RadixKey<Key, typename std::enable_if<std::is_integral<Key>::value>::type>
+{
+	using Bits = typename RadixBits<sizeof(Key)>::Type;
+
+	static Bits toBits(Key key)
+	{
+		// Flipping the sign bit puts the negative numbers first
+		Bits bits = static_cast<Bits>(key);
+
+		if (std::is_signed<Key>::value)
+			bits ^= Bits(1) << (sizeof(Key) * 8 - 1);
+
+		return bits;
+	}
+};
+
+template <typename Key>
+struct RadixKey<Key, typename std::enable_if<std::is_floating_point<Key>::value>::type>
+{
+	using Bits = typename RadixBits<sizeof(Key)>::Type;
+
+	static Bits toBits(Key key)
+	{
+		// Positive numbers get the sign bit set, negative ones get all bits flipped so that
+		// the bigger magnitudes come first. NaNs end up on the ends, depending on their sign
+		Bits bits;
+		std::memcpy(&bits, &key, sizeof(Key));
+
+		Bits sign = Bits(1) << (sizeof(Key) * 8 - 1);
+		return bits & sign ? ~bits : bits | sign;
+	}
+};
+
+// Where radixSort keeps the elements between passes. Only ever grows, so one scratch
+// reused across calls stops allocating once it has seen the biggest input
+class RadixScratch
+{
+public:
+	RadixScratch();
+	RadixScratch(const RadixScratch& other) = delete;
+	~RadixScratch();
+
+	RadixScratch& operator= (const RadixScratch& other) = delete;
+
+	void* get(std::size_t bytes);
+	std::size_t capacity() const;
+	// Gives the buffer back, the next get allocates again
+	void release();
+
+	// One for each thread, used when no scratch is passed. It only serves inputs up to LOCAL_LIMIT bytes,
+	// so a thread that once sorted something huge does not keep a huge buffer until it exits
+	static RadixScratch& local();
+	static const std::size_t LOCAL_LIMIT = 1 << 20;
+
+private:
+	void* m_Data;
+	std::size_t m_Capacity;
+};
+
+inline RadixScratch::RadixScratch()
+	: m_Data(nullptr), m_Capacity(0)
+{
+}
+
+inline RadixScratch::~RadixScratch()
+{
+	::operator delete(m_Data);
+}
+
+inline void* RadixScratch::get(std::size_t bytes)
+{
+	if (bytes > m_Capacity)
+	{
+		void* data = ::operator new(bytes);
+		::operator delete(m_Data);
+
+		m_Data = data;
+		m_Capacity = bytes;
+	}
+
+	return m_Data;
+}
+
+inline std::size_t RadixScratch::capacity() const
+{
+	return m_Capacity;
+}
+
+inline void RadixScratch::release()
+{
+	::operator delete(m_Data);
+
+	m_Data = nullptr;
+	m_Capacity = 0;
+}
+
+inline RadixScratch& RadixScratch::local()
+{
+	thread_local RadixScratch scratch;
+	return scratch;
+}
+
+template <typename Type, typename KeyOf>
+void radixSort(Type* first, Type* last, KeyOf keyOf, RadixScratch& scratch)
+{
+	static_assert(std::is_trivially_copyable<Type>::value, "radixSort moves the elements around with memcpy");
+	static_assert(alignof(Type) <= alignof(std::max_align_t), "The scratch buffer is not aligned enough for this type");
+
+	using Key = typename std::decay<decltype(keyOf(*first))>::type;
+	using Bits = typename RadixKey<Key>::Bits;
+
+	const std::size_t passes = sizeof(Bits);
+	std::size_t size = last - first;
+
+	if (size < 2)
+		return;
+
+	// All the histograms are counted in a single read of the input
+	std::size_t counts[passes][256] = {};
+
+	for (Type* current = first; current != last; ++current)
+	{
+		Bits bits = RadixKey<Key>::toBits(keyOf(*current));
+
+		for (std::size_t pass = 0; pass < passes; ++pass)
+			++counts[pass][(bits >> (pass * 8)) & 0xFF];
+	}
+
+	Type* source = first;
+	Type* dest = static_cast<Type*>(scratch.get(size * sizeof(Type)));
+
+	for (std::size_t pass = 0; pass < passes; ++pass)
+	{
+		std::size_t* count = counts[pass];
+		std::size_t shift = pass * 8;
+
+		// A byte that is the same in every key would not move anything
+		if (count[(RadixKey<Key>::toBits(keyOf(*source)) >> shift) & 0xFF] == size)
+			continue;
+
+		std::size_t offsets[256];
+		std::size_t offset = 0;
+
+		for (std::size_t digit = 0; digit < 256; ++digit)
+		{
+			offsets[digit] = offset;
+			offset += count[digit];
+		}
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			std::size_t digit = (RadixKey<Key>::toBits(keyOf(source[i])) >> shift) & 0xFF;
+			std::memcpy(static_cast<void*>(dest + offsets[digit]++), source + i, sizeof(Type));
+		}
+
+		Type* temp = source;
+		source = dest;
+		dest = temp;
+	}
+
+	if (source != first)
+		std::memcpy(static_cast<void*>(first), source, size * sizeof(Type));
+}
+
+#endif // !RADIX_SORT_H
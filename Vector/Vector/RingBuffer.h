@@ -0,0 +1,649 @@
+#ifndef RING_BUFFER_H
+
+#define RING_BUFFER_H
+
+#include "GrowthPolicy.h"
+
+#include <type_traits>
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+#include <memory>
+#include <new>
+
+enum class RingMode
+{
+	// Pushing into a full buffer grows it
+	Grow,
+	// The capacity is fixed, pushing into a full buffer drops the element at the other end
+	Overwrite
+};
+
+// A double ended queue over one circular buffer. The buffer size is a power of two,
+// so wrapping around is a mask instead of a division, and both ends push and pop in O(1).
+// Element 0 is the front.
+template <typename Type>
+class RingBuffer
+{
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using reference = Type&;
+	using const_reference = const Type&;
+
+	RingBuffer();
+	// In Overwrite mode exactly capacity elements are kept, in Grow mode it is only reserved
+	explicit RingBuffer(size_type capacity, RingMode mode = RingMode::Grow);
+	RingBuffer(const RingBuffer& other);
+	RingBuffer(RingBuffer&& other) noexcept;
+	~RingBuffer();
+
+	RingBuffer& operator= (const RingBuffer& other);
+	RingBuffer& operator= (RingBuffer&& other) noexcept;
+
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
+
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
+
+	Type& back();
+	Type& front();
+	const Type& back() const;
+	const Type& front() const;
+
+	size_type size() const;
+	size_type capacity() const;
+	bool empty() const;
+	bool full() const;
+	RingMode mode() const;
+
+	// Does nothing in Overwrite mode
+	void reserve(size_type newCapacity);
+	void clear();
+
+	void pushBack(const Type& el);
+	void pushBack(Type&& el);
+	void pushFront(const Type& el);
+	void pushFront(Type&& el);
+	template <typename... Args>
+	Type& emplaceBack(Args&&... args);
+	template <typename... Args>
+	Type& emplaceFront(Args&&... args);
+	void popBack();
+	void popFront();
+
+private:
+	Type* m_Data;
+	// The size of m_Data, zero or a power of two
+	size_type m_Capacity;
+	size_type m_Head;
+	size_type m_Size;
+	// The most elements kept in Overwrite mode
+	size_type m_Limit;
+	RingMode m_Mode;
+
+	Type* slot(size_type index) const;
+	void reallocate(size_type newCapacity);
+	template <typename... Args>
+	Type& emplaceAt(bool atBack, Args&&... args);
+	void copy(const RingBuffer& other);
+	void steal(RingBuffer& other);
+	void freeMemory();
+
+	static size_type roundUp(size_type capacity);
+};
+
+template<typename Type>
+inline RingBuffer<Type>::RingBuffer()
+	: m_Data(nullptr), m_Capacity(0), m_Head(0), m_Size(0), m_Limit(0), m_Mode(RingMode::Grow)
+{
+}
+
+template<typename Type>
+inline RingBuffer<Type>::RingBuffer(size_type capacity, RingMode mode)
+	: RingBuffer()
+{
+	if (mode == RingMode::Overwrite && capacity == 0)
+		throw std::invalid_argument("The capacity can not be zero!");
+
+	m_Mode = mode;
+	m_Limit = capacity;
+
+	if (capacity > 0)
+		reallocate(roundUp(capacity));
+}
+
+template<typename Type>
+inline RingBuffer<Type>::RingBuffer(const RingBuffer& other)
+	: RingBuffer()
+{
+	copy(other);
+}
+
+template<typename Type>
+inline RingBuffer<Type>::RingBuffer(RingBuffer&& other) noexcept
+	: RingBuffer()
+{
+	steal(other);
+}
+
+template<typename Type>
+inline RingBuffer<Type>::~RingBuffer()
+{
+	freeMemory();
+}
+
+template<typename Type>
+inline RingBuffer<Type>& RingBuffer<Type>::operator= (const RingBuffer& other)
+{
+	if (this != &other)
+	{
+		RingBuffer temp(other);
+		freeMemory();
+		steal(temp);
+	}
+
+	return *this;
+}
+
+template<typename Type>
+inline RingBuffer<Type>& RingBuffer<Type>::operator= (RingBuffer&& other) noexcept
+{
+	if (this != &other)
+	{
+		freeMemory();
+		steal(other);
+	}
+
+	return *this;
+}
+
+template<typename Type>
+inline Type& RingBuffer<Type>::operator[] (size_type index)
+{
+	return *slot(index);
+}
+
+template<typename Type>
+inline const Type& RingBuffer<Type>::operator[] (size_type index) const
+{
+	return *slot(index);
+}
+
+template<typename Type>
+inline Type& RingBuffer<Type>::at(size_type index)
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return *slot(index);
+}
+
+template<typename Type>
+inline const Type& RingBuffer<Type>::at(size_type index) const
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return *slot(index);
+}
+
+template<typename Type>
+inline Type& RingBuffer<Type>::back()
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	return *slot(m_Size - 1);
+}
+
+template<typename Type>
+inline Type& RingBuffer<Type>::front()
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	return *slot(0);
+}
+
+template<typename Type>
+inline const Type& RingBuffer<Type>::back() const
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	return *slot(m_Size - 1);
+}
+
+template<typename Type>
+inline const Type& RingBuffer<Type>::front() const
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	return *slot(0);
+}
+
+template<typename Type>
+inline std::size_t RingBuffer<Type>::size() const
+{
+	return m_Size;
+}
+
+template<typename Type>
+inline std::size_t RingBuffer<Type>::capacity() const
+{
+	return m_Mode == RingMode::Overwrite ? m_Limit : m_Capacity;
+}
+
+template<typename Type>
+inline bool RingBuffer<Type>::empty() const
+{
+	return m_Size == 0;
+}
+
+template<typename Type>
+inline bool RingBuffer<Type>::full() const
+{
+	return m_Size == capacity();
+}
+
+template<typename Type>
+inline RingMode RingBuffer<Type>::mode() const
+{
+	return m_Mode;
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::reserve(size_type newCapacity)
+{
+	if (m_Mode == RingMode::Grow && newCapacity > m_Capacity)
+		reallocate(roundUp(newCapacity));
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::clear()
+{
+	while (!empty())
+		popBack();
+
+	m_Head = 0;
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::pushBack(const Type& el)
+{
+	emplaceBack(el);
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::pushBack(Type&& el)
+{
+	emplaceBack(std::move(el));
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::pushFront(const Type& el)
+{
+	emplaceFront(el);
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::pushFront(Type&& el)
+{
+	emplaceFront(std::move(el));
+}
+
+template<typename Type>
+template<typename... Args>
+inline Type& RingBuffer<Type>::emplaceBack(Args&&... args)
+{
+	return emplaceAt(true, std::forward<Args>(args)...);
+}
+
+template<typename Type>
+template<typename... Args>
+inline Type& RingBuffer<Type>::emplaceFront(Args&&... args)
+{
+	return emplaceAt(false, std::forward<Args>(args)...);
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::popBack()
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	slot(--m_Size)->~Type();
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::popFront()
+{
+	if (empty())
+		throw std::logic_error("The buffer is empty!");
+
+	slot(0)->~Type();
+	m_Head = (m_Head + 1) & (m_Capacity - 1);
+	--m_Size;
+}
+
+template<typename Type>
+inline Type* RingBuffer<Type>::slot(size_type index) const
+{
+	return m_Data + ((m_Head + index) & (m_Capacity - 1));
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::reallocate(size_type newCapacity)
+{
+	// The elements go to the start of the new buffer, in order
+	Type* data = std::allocator<Type>().allocate(newCapacity);
+	size_type moved = 0;
+
+	try
+	{
+		for (; moved < m_Size; ++moved)
+			new (data + moved) Type(std::move_if_noexcept(*slot(moved)));
+	}
+	catch (...)
+	{
+		for (size_type i = 0; i < moved; ++i)
+			data[i].~Type();
+
+		std::allocator<Type>().deallocate(data, newCapacity);
+		throw;
+	}
+
+	size_type size = m_Size;
+	freeMemory();
+
+	m_Data = data;
+	m_Capacity = newCapacity;
+	m_Head = 0;
+	m_Size = size;
+}
+
+template<typename Type>
+template<typename... Args>
+inline Type& RingBuffer<Type>::emplaceAt(bool atBack, Args&&... args)
+{
+	if (m_Mode == RingMode::Overwrite && m_Size == m_Limit)
+	{
+		// Build it first, args may be the element that is about to be dropped
+		Type value(std::forward<Args>(args)...);
+
+		if (atBack)
+		{
+			popFront();
+			return emplaceAt(true, std::move(value));
+		}
+
+		popBack();
+		return emplaceAt(false, std::move(value));
+	}
+
+	if (m_Size == m_Capacity)
+	{
+		// The new element is built in the new buffer before the old one goes away, since args may point into it.
+		// Pushing to the front leaves a slot free before the moved elements
+		size_type newCapacity = PowerOfTwoGrowth::nextCapacity(m_Capacity, m_Size + 1);
+		Type* data = std::allocator<Type>().allocate(newCapacity);
+		Type* place = data + (atBack ? m_Size : 0);
+
+		try
+		{
+			new (place) Type(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			std::allocator<Type>().deallocate(data, newCapacity);
+			throw;
+		}
+
+		size_type offset = atBack ? 0 : 1;
+		size_type moved = 0;
+
+		try
+		{
+			for (; moved < m_Size; ++moved)
+				new (data + offset + moved) Type(std::move_if_noexcept(*slot(moved)));
+		}
+		catch (...)
+		{
+			for (size_type i = 0; i < moved; ++i)
+				data[offset + i].~Type();
+
+			place->~Type();
+			std::allocator<Type>().deallocate(data, newCapacity);
+			throw;
+		}
+
+		size_type size = m_Size;
+		freeMemory();
+
+		m_Data = data;
+		m_Capacity = newCapacity;
+		m_Head = 0;
+		m_Size = size + 1;
+
+		return *place;
+	}
+
+	if (atBack)
+	{
+		Type* place = slot(m_Size);
+		new (place) Type(std::forward<Args>(args)...);
+		++m_Size;
+		return *place;
+	}
+
+	size_type head = (m_Head + m_Capacity - 1) & (m_Capacity - 1);
+	new (m_Data + head) Type(std::forward<Args>(args)...);
+	m_Head = head;
+	++m_Size;
+
+	return m_Data[head];
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::copy(const RingBuffer& other)
+{
+	m_Mode = other.m_Mode;
+	m_Limit = other.m_Limit;
+
+	if (other.m_Capacity == 0)
+		return;
+
+	reallocate(other.m_Capacity);
+
+	for (size_type i = 0; i < other.m_Size; ++i)
+		emplaceBack(other[i]);
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::steal(RingBuffer& other)
+{
+	m_Data = other.m_Data;
+	m_Capacity = other.m_Capacity;
+	m_Head = other.m_Head;
+	m_Size = other.m_Size;
+	m_Limit = other.m_Limit;
+	m_Mode = other.m_Mode;
+
+	other.m_Data = nullptr;
+	other.m_Capacity = 0;
+	other.m_Head = 0;
+	other.m_Size = 0;
+}
+
+template<typename Type>
+inline void RingBuffer<Type>::freeMemory()
+{
+	if (!m_Data)
+		return;
+
+	for (size_type i = 0; i < m_Size; ++i)
+		slot(i)->~Type();
+
+	std::allocator<Type>().deallocate(m_Data, m_Capacity);
+
+	m_Data = nullptr;
+	m_Capacity = 0;
+	m_Head = 0;
+	m_Size = 0;
+}
+
+template<typename Type>
+inline std::size_t RingBuffer<Type>::roundUp(size_type capacity)
+{
+	return capacity == 0 ? 0 : PowerOfTwoGrowth::nextCapacity(0, capacity);
+}
+
+// A fixed size queue for exactly one producer thread and one consumer thread, without locks.
+// Each side owns one index and only reads the other's, the indices sit on their own cache lines
+// and each side keeps a cached copy of the other's index, so most calls touch no shared line at all.
+template <typename Type>
+class SpscRingBuffer
+{
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+
+	// The capacity is rounded up to a power of two
+	explicit SpscRingBuffer(size_type capacity);
+	SpscRingBuffer(const SpscRingBuffer& other) = delete;
+	~SpscRingBuffer();
+
+	SpscRingBuffer& operator= (const SpscRingBuffer& other) = delete;
+
+	// Producer side, false when the queue is full
+	bool tryPush(const Type& el);
+	bool tryPush(Type&& el);
+	template <typename... Args>
+	bool tryEmplace(Args&&... args);
+
+	// Consumer side, false when the queue is empty
+	bool tryPop(Type& out);
+
+	// Exact only when called from one of the two sides while the other one is idle
+	size_type size() const;
+	bool empty() const;
+	size_type capacity() const;
+
+private:
+	static const size_type CACHE_LINE = 64;
+
+	// The indices only ever grow, the slot is index & m_Mask
+	alignas(CACHE_LINE) std::atomic<size_type> m_Tail;
+	size_type m_CachedHead;
+
+	alignas(CACHE_LINE) std::atomic<size_type> m_Head;
+	size_type m_CachedTail;
+
+	alignas(CACHE_LINE) Type* m_Data;
+	size_type m_Mask;
+};
+
+template<typename Type>
+inline SpscRingBuffer<Type>::SpscRingBuffer(size_type capacity)
+	: m_Tail(0), m_CachedHead(0), m_Head(0), m_CachedTail(0)
+{
+	if (capacity == 0)
+		throw std::invalid_argument("The capacity can not be zero!");
+
+	size_type size = PowerOfTwoGrowth::nextCapacity(0, capacity);
+
+	m_Data = std::allocator<Type>().allocate(size);
+	m_Mask = size - 1;
+}
+
+template<typename Type>
+inline SpscRingBuffer<Type>::~SpscRingBuffer()
+{
+	size_type tail = m_Tail.load(std::memory_order_relaxed);
+
+	for (size_type i = m_Head.load(std::memory_order_relaxed); i != tail; ++i)
+		m_Data[i & m_Mask].~Type();
+
+	std::allocator<Type>().deallocate(m_Data, m_Mask + 1);
+}
+
+template<typename Type>
+inline bool SpscRingBuffer<Type>::tryPush(const Type& el)
+{
+	return tryEmplace(el);
+}
+
+template<typename Type>
+inline bool SpscRingBuffer<Type>::tryPush(Type&& el)
+{
+	return tryEmplace(std::move(el));
+}
+
+template<typename Type>
+template<typename... Args>
+inline bool SpscRingBuffer<Type>::tryEmplace(Args&&... args)
+{
+	size_type tail = m_Tail.load(std::memory_order_relaxed);
+
+	if (tail - m_CachedHead > m_Mask)
+	{
+		// Looks full, see how far the consumer really got
+		m_CachedHead = m_Head.load(std::memory_order_acquire);
+
+		if (tail - m_CachedHead > m_Mask)
+			return false;
+	}
+
+	new (m_Data + (tail & m_Mask)) Type(std::forward<Args>(args)...);
+	m_Tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+template<typename Type>
+inline bool SpscRingBuffer<Type>::tryPop(Type& out)
+{
+	size_type head = m_Head.load(std::memory_order_relaxed);
+
+	if (head == m_CachedTail)
+	{
+		m_CachedTail = m_Tail.load(std::memory_order_acquire);
+
+		if (head == m_CachedTail)
+			return false;
+	}
+
+	Type* place = m_Data + (head & m_Mask);
+	out = std::move(*place);
+	place->~Type();
+
+	m_Head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+template<typename Type>
+inline std::size_t SpscRingBuffer<Type>::size() const
+{
+	// Head first, the tail can only be further along by the time it is read
+	size_type head = m_Head.load(std::memory_order_acquire);
+	return m_Tail.load(std::memory_order_acquire) - head;
+}
+
+template<typename Type>
+inline bool SpscRingBuffer<Type>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename Type>
+inline std::size_t SpscRingBuffer<Type>::capacity() const
+{
+	return m_Mask + 1;
+}
+
+#endif // !RING_BUFFER_H
@@ -0,0 +1,367 @@
+#ifndef SEGMENTED_VECTOR_H
+
+#define SEGMENTED_VECTOR_H
+
+#include "Vector.h"
+
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <memory>
+
+// A vector made of fixed size chunks. Growing only allocates one more chunk, so nothing is ever
+// copied or moved and references to the elements stay valid until the element is removed.
+// ChunkSize is a power of two, so finding an element is a shift and a mask.
+// Within a chunk the elements are contiguous, forEachChunk walks them a chunk at a time.
+template <typename Type, std::size_t ChunkSize = 1024>
+class SegmentedVector
+{
+	static_assert(ChunkSize > 0 && (ChunkSize & (ChunkSize - 1)) == 0, "ChunkSize must be a power of two");
+
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using reference = Type&;
+	using const_reference = const Type&;
+
+	SegmentedVector();
+	SegmentedVector(const SegmentedVector& other);
+	SegmentedVector(SegmentedVector&& other) noexcept;
+	~SegmentedVector();
+
+	SegmentedVector& operator= (const SegmentedVector& other);
+	SegmentedVector& operator= (SegmentedVector&& other) noexcept;
+
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
+
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
+
+	Type& back();
+	Type& front();
+	const Type& back() const;
+	const Type& front() const;
+
+	size_type size() const;
+	size_type capacity() const;
+	bool empty() const;
+
+	void reserve(size_type newCapacity);
+	// Frees the chunks that hold no elements
+	void shrinkToFit();
+
+	// Keeps the chunks
+	void clear();
+	void pushBack(const Type& el);
+	void pushBack(Type&& el);
+	template <typename... Args>
+	Type& emplaceBack(Args&&... args);
+	void popBack();
+
+	// Calls func(Type* data, size_type count) for every chunk that holds elements, in order
+	template <typename Func>
+	void forEachChunk(Func func);
+	template <typename Func>
+	void forEachChunk(Func func) const;
+
+private:
+	Vector<Type*> m_Chunks;
+	size_type m_Size;
+
+	static constexpr size_type chunkShift()
+	{
+		size_type shift = 0;
+
+		while ((size_type(1) << shift) < ChunkSize)
+			++shift;
+
+		return shift;
+	}
+
+	static constexpr size_type SHIFT = chunkShift();
+	static constexpr size_type MASK = ChunkSize - 1;
+
+	Type* slot(size_type index) const;
+	void addChunk();
+	void freeChunks(size_type from);
+	void copy(const SegmentedVector& other);
+	void steal(SegmentedVector& other);
+};
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>::SegmentedVector()
+	: m_Size(0)
+{
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>::SegmentedVector(const SegmentedVector& other)
+	: SegmentedVector()
+{
+	// Delegating makes this a constructed object, so the destructor cleans up if a copy throws
+	copy(other);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>::SegmentedVector(SegmentedVector&& other) noexcept
+	: m_Size(0)
+{
+	steal(other);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>::~SegmentedVector()
+{
+	clear();
+	freeChunks(0);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>& SegmentedVector<Type, ChunkSize>::operator= (const SegmentedVector& other)
+{
+	if (this != &other)
+	{
+		clear();
+		copy(other);
+	}
+
+	return *this;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline SegmentedVector<Type, ChunkSize>& SegmentedVector<Type, ChunkSize>::operator= (SegmentedVector&& other) noexcept
+{
+	if (this != &other)
+	{
+		clear();
+		freeChunks(0);
+		steal(other);
+	}
+
+	return *this;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline Type& SegmentedVector<Type, ChunkSize>::operator[] (size_type index)
+{
+	return *slot(index);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline const Type& SegmentedVector<Type, ChunkSize>::operator[] (size_type index) const
+{
+	return *slot(index);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline Type& SegmentedVector<Type, ChunkSize>::at(size_type index)
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return *slot(index);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline const Type& SegmentedVector<Type, ChunkSize>::at(size_type index) const
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return *slot(index);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline Type& SegmentedVector<Type, ChunkSize>::back()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return *slot(m_Size - 1);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline Type& SegmentedVector<Type, ChunkSize>::front()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return *slot(0);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline const Type& SegmentedVector<Type, ChunkSize>::back() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return *slot(m_Size - 1);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline const Type& SegmentedVector<Type, ChunkSize>::front() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return *slot(0);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline std::size_t SegmentedVector<Type, ChunkSize>::size() const
+{
+	return m_Size;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline std::size_t SegmentedVector<Type, ChunkSize>::capacity() const
+{
+	return m_Chunks.size() * ChunkSize;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline bool SegmentedVector<Type, ChunkSize>::empty() const
+{
+	return m_Size == 0;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::reserve(size_type newCapacity)
+{
+	size_type chunks = (newCapacity + MASK) >> SHIFT;
+
+	m_Chunks.reserve(chunks);
+
+	while (m_Chunks.size() < chunks)
+		addChunk();
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::shrinkToFit()
+{
+	freeChunks((m_Size + MASK) >> SHIFT);
+	m_Chunks.shrinkToFit();
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::clear()
+{
+	if constexpr (!std::is_trivially_destructible<Type>::value)
+	{
+		forEachChunk([](Type* data, size_type count)
+		{
+			for (size_type i = 0; i < count; ++i)
+				data[i].~Type();
+		});
+	}
+
+	m_Size = 0;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::pushBack(const Type& el)
+{
+	emplaceBack(el);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::pushBack(Type&& el)
+{
+	emplaceBack(std::move(el));
+}
+
+template<typename Type, std::size_t ChunkSize>
+template<typename... Args>
+inline Type& SegmentedVector<Type, ChunkSize>::emplaceBack(Args&&... args)
+{
+	// Nothing moves when a chunk is added, so args may safely refer to our own elements
+	if (m_Size == capacity())
+		addChunk();
+
+	Type* place = slot(m_Size);
+	new (place) Type(std::forward<Args>(args)...);
+	++m_Size;
+
+	return *place;
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::popBack()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	slot(--m_Size)->~Type();
+}
+
+template<typename Type, std::size_t ChunkSize>
+template<typename Func>
+inline void SegmentedVector<Type, ChunkSize>::forEachChunk(Func func)
+{
+	for (size_type start = 0; start < m_Size; start += ChunkSize)
+		func(m_Chunks[start >> SHIFT], m_Size - start < ChunkSize ? m_Size - start : ChunkSize);
+}
+
+template<typename Type, std::size_t ChunkSize>
+template<typename Func>
+inline void SegmentedVector<Type, ChunkSize>::forEachChunk(Func func) const
+{
+	for (size_type start = 0; start < m_Size; start += ChunkSize)
+		func(static_cast<const Type*>(m_Chunks[start >> SHIFT]), m_Size - start < ChunkSize ? m_Size - start : ChunkSize);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline Type* SegmentedVector<Type, ChunkSize>::slot(size_type index) const
+{
+	return m_Chunks[index >> SHIFT] + (index & MASK);
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::addChunk()
+{
+	Type* chunk = std::allocator<Type>().allocate(ChunkSize);
+
+	try
+	{
+		m_Chunks.pushBack(chunk);
+	}
+	catch (...)
+	{
+		std::allocator<Type>().deallocate(chunk, ChunkSize);
+		throw;
+	}
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::freeChunks(size_type from)
+{
+	while (m_Chunks.size() > from)
+	{
+		std::allocator<Type>().deallocate(m_Chunks.back(), ChunkSize);
+		m_Chunks.popBack();
+	}
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::copy(const SegmentedVector& other)
+{
+	reserve(other.m_Size);
+
+	other.forEachChunk([this](const Type* data, size_type count)
+	{
+		for (size_type i = 0; i < count; ++i)
+			emplaceBack(data[i]);
+	});
+}
+
+template<typename Type, std::size_t ChunkSize>
+inline void SegmentedVector<Type, ChunkSize>::steal(SegmentedVector& other)
+{
+	m_Chunks = std::move(other.m_Chunks);
+	m_Size = other.m_Size;
+
+	other.m_Size = 0;
+}
+
+#endif // !SEGMENTED_VECTOR_H
@@ -0,0 +1,392 @@
+#ifndef SHARED_VECTOR_H
+
+#define SHARED_VECTOR_H
+
+#include "Vector.h"
+
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <atomic>
+
+// A copy-on-write handle to a Vector. Copies share one buffer and only bump a reference count,
+// the first change through a handle that is shared makes a private copy for that handle.
+// The count is atomic, so handles to the same buffer can be copied and dropped from any thread.
+// A single handle is not thread safe, just like a Vector.
+//
+// Everything that can change the elements unshares first, the non-const operator[] included.
+// Read through a const handle (or vector()) to keep sharing.
+// The non-const operator[], at and emplaceBack hand out a reference that can change the buffer later,
+// so they also mark it unshareable. Copies of that handle get their own buffer right away, until clear().
+template <typename Type>
+class SharedVector
+{
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using reference = Type&;
+	using const_reference = const Type&;
+
+	SharedVector();
+	explicit SharedVector(Vector<Type> vector);
+	SharedVector(const SharedVector& other);
+	SharedVector(SharedVector&& other) noexcept;
+	~SharedVector();
+
+	SharedVector& operator= (const SharedVector& other);
+	SharedVector& operator= (SharedVector&& other) noexcept;
+
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
+
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
+
+	const Type& back() const;
+	const Type& front() const;
+
+	// The whole vector, read only. Valid until this handle changes or dies
+	const Vector<Type>& vector() const;
+	const Type* data() const;
+	size_type size() const;
+	bool empty() const;
+
+	// How many handles share the buffer, 0 for an empty handle that has none
+	size_type useCount() const;
+	bool isShared() const;
+
+	void reserve(size_type newCapacity);
+	void resize(size_type newSize);
+	void clear();
+	void insert(const Type* data, size_type dataSize);
+	void erase(size_type index);
+	void erase(size_type first, size_type last);
+	void pushBack(const Type& el);
+	void pushBack(Type&& el);
+	template <typename... Args>
+	Type& emplaceBack(Args&&... args);
+	void popBack();
+
+private:
+	struct Block
+	{
+		std::atomic<size_type> references;
+		Vector<Type> vector;
+		// False once a reference to an element was handed out, only the handle that owns the block touches it
+		bool shareable;
+
+		explicit Block(Vector<Type>&& vector) : references(1), vector(std::move(vector)), shareable(true) {}
+	};
+
+	Block* m_Block;
+
+	// Makes sure this handle is the only one on its buffer and returns the vector to change
+	Vector<Type>& unshare();
+	// Same as unshare, for callers that hand out a reference into the buffer
+	Vector<Type>& pin();
+	void release();
+
+	template <typename... Args>
+	Type& append(Args&&... args);
+
+	// The block a copy of a handle on block uses, a new one if block can not be shared
+	static Block* share(Block* block);
+
+	static const Vector<Type>& emptyVector();
+};
+
+template<typename Type>
+inline SharedVector<Type>::SharedVector()
+	: m_Block(nullptr)
+{
+}
+
+template<typename Type>
+inline SharedVector<Type>::SharedVector(Vector<Type> vector)
+	: m_Block(new Block(std::move(vector)))
+{
+}
+
+template<typename Type>
+inline SharedVector<Type>::SharedVector(const SharedVector& other)
+	: m_Block(share(other.m_Block))
+{
+}
+
+template<typename Type>
+inline SharedVector<Type>::SharedVector(SharedVector&& other) noexcept
+	: m_Block(other.m_Block)
+{
+	other.m_Block = nullptr;
+}
+
+template<typename Type>
+inline SharedVector<Type>::~SharedVector()
+{
+	release();
+}
+
+template<typename Type>
+inline SharedVector<Type>& SharedVector<Type>::operator= (const SharedVector& other)
+{
+	if (m_Block != other.m_Block)
+	{
+		Block* block = share(other.m_Block);
+
+		release();
+		m_Block = block;
+	}
+
+	return *this;
+}
+
+template<typename Type>
+inline SharedVector<Type>& SharedVector<Type>::operator= (SharedVector&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		m_Block = other.m_Block;
+		other.m_Block = nullptr;
+	}
+
+	return *this;
+}
+
+template<typename Type>
+inline Type& SharedVector<Type>::operator[] (size_type index)
+{
+	return pin()[index];
+}
+
+template<typename Type>
+inline const Type& SharedVector<Type>::operator[] (size_type index) const
+{
+	return vector()[index];
+}
+
+template<typename Type>
+inline Type& SharedVector<Type>::at(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	return pin()[index];
+}
+
+template<typename Type>
+inline const Type& SharedVector<Type>::at(size_type index) const
+{
+	return vector().at(index);
+}
+
+template<typename Type>
+inline const Type& SharedVector<Type>::back() const
+{
+	return vector().back();
+}
+
+template<typename Type>
+inline const Type& SharedVector<Type>::front() const
+{
+	return vector().front();
+}
+
+template<typename Type>
+inline const Vector<Type>& SharedVector<Type>::vector() const
+{
+	return m_Block ? m_Block->vector : emptyVector();
+}
+
+template<typename Type>
+inline const Type* SharedVector<Type>::data() const
+{
+	return vector().data();
+}
+
+template<typename Type>
+inline std::size_t SharedVector<Type>::size() const
+{
+	return m_Block ? m_Block->vector.size() : 0;
+}
+
+template<typename Type>
+inline bool SharedVector<Type>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename Type>
+inline std::size_t SharedVector<Type>::useCount() const
+{
+	return m_Block ? m_Block->references.load(std::memory_order_relaxed) : 0;
+}
+
+template<typename Type>
+inline bool SharedVector<Type>::isShared() const
+{
+	return useCount() > 1;
+}
+
+template<typename Type>
+inline void SharedVector<Type>::reserve(size_type newCapacity)
+{
+	unshare().reserve(newCapacity);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::resize(size_type newSize)
+{
+	unshare().resize(newSize);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::clear()
+{
+	// No point copying what is about to go away
+	if (isShared())
+	{
+		release();
+		m_Block = nullptr;
+		return;
+	}
+
+	// The references handed out die with the elements
+	if (m_Block)
+	{
+		m_Block->vector.clear();
+		m_Block->shareable = true;
+	}
+}
+
+template<typename Type>
+inline void SharedVector<Type>::insert(const Type* data, size_type dataSize)
+{
+	// Same as in append, data may point into the shared buffer
+	if (isShared())
+	{
+		SharedVector keep(*this);
+		unshare().insert(data, dataSize);
+		return;
+	}
+
+	unshare().insert(data, dataSize);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::erase(size_type index)
+{
+	unshare().erase(index);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::erase(size_type first, size_type last)
+{
+	unshare().erase(first, last);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::pushBack(const Type& el)
+{
+	append(el);
+}
+
+template<typename Type>
+inline void SharedVector<Type>::pushBack(Type&& el)
+{
+	append(std::move(el));
+}
+
+template<typename Type>
+template<typename... Args>
+inline Type& SharedVector<Type>::emplaceBack(Args&&... args)
+{
+	Type& el = append(std::forward<Args>(args)...);
+	m_Block->shareable = false;
+
+	return el;
+}
+
+template<typename Type>
+inline void SharedVector<Type>::popBack()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	unshare().popBack();
+}
+
+template<typename Type>
+inline Vector<Type>& SharedVector<Type>::unshare()
+{
+	if (!m_Block)
+	{
+		m_Block = new Block(Vector<Type>());
+		return m_Block->vector;
+	}
+
+	// Acquire, so the writes of handles that already let go are visible before we change the buffer
+	if (m_Block->references.load(std::memory_order_acquire) == 1)
+		return m_Block->vector;
+
+	Block* copy = new Block(Vector<Type>(m_Block->vector));
+
+	release();
+	m_Block = copy;
+
+	return m_Block->vector;
+}
+
+template<typename Type>
+template<typename... Args>
+inline Type& SharedVector<Type>::append(Args&&... args)
+{
+	// args may point into the shared buffer, which another thread could free once we let go of it
+	if (isShared())
+	{
+		SharedVector keep(*this);
+		return unshare().emplaceBack(std::forward<Args>(args)...);
+	}
+
+	return unshare().emplaceBack(std::forward<Args>(args)...);
+}
+
+template<typename Type>
+inline Vector<Type>& SharedVector<Type>::pin()
+{
+	Vector<Type>& vector = unshare();
+	m_Block->shareable = false;
+
+	return vector;
+}
+
+template<typename Type>
+inline void SharedVector<Type>::release()
+{
+	if (m_Block && m_Block->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		delete m_Block;
+}
+
+template<typename Type>
+inline typename SharedVector<Type>::Block* SharedVector<Type>::share(Block* block)
+{
+	if (!block)
+		return nullptr;
+
+	if (!block->shareable)
+		return new Block(Vector<Type>(block->vector));
+
+	// Whoever copies already holds a reference, so a relaxed increment is enough
+	block->references.fetch_add(1, std::memory_order_relaxed);
+
+	return block;
+}
+
+template<typename Type>
+inline const Vector<Type>& SharedVector<Type>::emptyVector()
+{
+	static const Vector<Type> empty;
+	return empty;
+}
+
+#endif // !SHARED_VECTOR_H
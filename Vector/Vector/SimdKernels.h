@@ -0,0 +1,642 @@
+#ifndef SIMD_KERNELS_H
+
+#define SIMD_KERNELS_H
+
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+// Vectorized sum / dot / min / max / count / find over float, double, int32_t and int64_t.
+// On x86 every call picks AVX2 or SSE2 at runtime, everywhere else (or with VECTOR_NO_SIMD) plain loops are used.
+// Integer sums and dot products are returned as int64_t and wrap around on overflow.
+
+#if !defined(VECTOR_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define VECTOR_SIMD_X86
+#endif
+
+#ifdef VECTOR_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+inline unsigned simdPopCount(unsigned mask)
+{
+	unsigned count = 0;
+
+	for (; mask; mask &= mask - 1)
+		++count;
+
+	return count;
+}
+
+inline unsigned simdLowestBit(unsigned mask)
+{
+	unsigned index = 0;
+
+	for (; !(mask & 1u); mask >>= 1)
+		++index;
+
+	return index;
+}
+
+template <typename Type>
+struct SimdScalarAdd
+{
+	static Type add(Type lhs, Type rhs)
+	{
+		if constexpr (std::is_integral<Type>::value)
+			return static_cast<Type>(static_cast<std::make_unsigned_t<Type>>(lhs) + static_cast<std::make_unsigned_t<Type>>(rhs));
+		else
+			return lhs + rhs;
+	}
+};
+
+#ifdef VECTOR_SIMD_X86
+
+inline bool simdHasAvx2()
+{
+	static const bool hasAvx2 = []()
+	{
+#if defined(_MSC_VER)
+		int info[4];
+		__cpuid(info, 1);
+
+		// The CPU has to support AVX and the OS has to save the YMM registers
+		bool osSavesYmm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+
+		if (!osSavesYmm)
+			return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1] & (1 << 5)) != 0;
+#else
+		__builtin_cpu_init();
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+	}();
+
+	return hasAvx2;
+}
+
+// -------- SSE2 --------
+
+template <typename Type>
+struct SimdSse2Ops;
+
+template <>
+struct SimdSse2Ops<float>
+{
+	using Type = float;
+	using SumType = float;
+	using Reg = __m128;
+	using Acc = __m128;
+
+	static constexpr std::size_t width = 4;
+	static constexpr bool hasDot = true;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm_loadu_ps(data); }
+	static Reg broadcast(Type value) { return _mm_set1_ps(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm_min_ps(lhs, rhs); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm_max_ps(lhs, rhs); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs))); }
+
+	static Acc accZero() { return _mm_setzero_ps(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm_add_ps(acc, value); }
+	static Acc accDot(Acc acc, Reg lhs, Reg rhs) { return _mm_add_ps(acc, _mm_mul_ps(lhs, rhs)); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm_add_ps(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return lhs + rhs; }
+
+	static SumType accReduce(Acc acc)
+	{
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, acc);
+		return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = lanes[i] < result ? lanes[i] : result;
+
+		return result;
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		alignas(16) float lanes[4];
+		_mm_store_ps(lanes, value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = result < lanes[i] ? lanes[i] : result;
+
+		return result;
+	}
+};
+
+template <>
+struct SimdSse2Ops<double>
+{
+	using Type = double;
+	using SumType = double;
+	using Reg = __m128d;
+	using Acc = __m128d;
+
+	static constexpr std::size_t width = 2;
+	static constexpr bool hasDot = true;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm_loadu_pd(data); }
+	static Reg broadcast(Type value) { return _mm_set1_pd(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm_min_pd(lhs, rhs); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm_max_pd(lhs, rhs); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs))); }
+
+	static Acc accZero() { return _mm_setzero_pd(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm_add_pd(acc, value); }
+	static Acc accDot(Acc acc, Reg lhs, Reg rhs) { return _mm_add_pd(acc, _mm_mul_pd(lhs, rhs)); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm_add_pd(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return lhs + rhs; }
+
+	static SumType accReduce(Acc acc)
+	{
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, acc);
+		return lanes[0] + lanes[1];
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, value);
+		return lanes[1] < lanes[0] ? lanes[1] : lanes[0];
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		alignas(16) double lanes[2];
+		_mm_store_pd(lanes, value);
+		return lanes[0] < lanes[1] ? lanes[1] : lanes[0];
+	}
+};
+
+template <>
+struct SimdSse2Ops<std::int32_t>
+{
+	using Type = std::int32_t;
+	using SumType = std::int64_t;
+	using Reg = __m128i;
+	using Acc = __m128i;
+
+	static constexpr std::size_t width = 4;
+	// SSE2 has neither a signed 32 bit multiply nor a 64 bit one
+	static constexpr bool hasDot = false;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+	static Reg broadcast(Type value) { return _mm_set1_epi32(value); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs)))); }
+
+	static Reg min(Reg lhs, Reg rhs)
+	{
+		__m128i lhsBigger = _mm_cmpgt_epi32(lhs, rhs);
+		return _mm_or_si128(_mm_and_si128(lhsBigger, rhs), _mm_andnot_si128(lhsBigger, lhs));
+	}
+
+	static Reg max(Reg lhs, Reg rhs)
+	{
+		__m128i lhsBigger = _mm_cmpgt_epi32(lhs, rhs);
+		return _mm_or_si128(_mm_and_si128(lhsBigger, lhs), _mm_andnot_si128(lhsBigger, rhs));
+	}
+
+	static Acc accZero() { return _mm_setzero_si128(); }
+
+	static Acc accAdd(Acc acc, Reg value)
+	{
+		// Sign extend to 64 bits by interleaving with the sign mask
+		__m128i sign = _mm_cmpgt_epi32(_mm_setzero_si128(), value);
+		acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(value, sign));
+		return _mm_add_epi64(acc, _mm_unpackhi_epi32(value, sign));
+	}
+
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm_add_epi64(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return SimdScalarAdd<SumType>::add(lhs, rhs); }
+
+	static SumType accReduce(Acc acc)
+	{
+		alignas(16) std::int64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+		return scalarAdd(lanes[0], lanes[1]);
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		alignas(16) std::int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = lanes[i] < result ? lanes[i] : result;
+
+		return result;
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		alignas(16) std::int32_t lanes[4];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = result < lanes[i] ? lanes[i] : result;
+
+		return result;
+	}
+};
+
+template <>
+struct SimdSse2Ops<std::int64_t>
+{
+	using Type = std::int64_t;
+	using SumType = std::int64_t;
+	using Reg = __m128i;
+	using Acc = __m128i;
+
+	static constexpr std::size_t width = 2;
+	// 64 bit compares and multiplies need SSE4.2 / AVX-512, those stay scalar
+	static constexpr bool hasDot = false;
+	static constexpr bool hasMinMax = false;
+
+	static Reg load(const Type* data) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data)); }
+	static Reg broadcast(Type value) { return _mm_set1_epi64x(value); }
+
+	static unsigned equalMask(Reg lhs, Reg rhs)
+	{
+		// A 64 bit lane is equal when both of its 32 bit halves are
+		__m128i halves = _mm_cmpeq_epi32(lhs, rhs);
+		__m128i swapped = _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1));
+		return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_and_si128(halves, swapped))));
+	}
+
+	static Acc accZero() { return _mm_setzero_si128(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm_add_epi64(acc, value); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm_add_epi64(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return SimdScalarAdd<SumType>::add(lhs, rhs); }
+
+	static SumType accReduce(Acc acc)
+	{
+		alignas(16) std::int64_t lanes[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+		return scalarAdd(lanes[0], lanes[1]);
+	}
+};
+
+#define SIMD_LOOPS SimdSse2Loops
+#include "SimdLoops.inl"
+#undef SIMD_LOOPS
+
+// -------- AVX2 --------
+// Everything up to the pop below is compiled for AVX2 and only ever called after simdHasAvx2()
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+template <typename Type>
+struct SimdAvx2Ops;
+
+template <>
+struct SimdAvx2Ops<float>
+{
+	using Type = float;
+	using SumType = float;
+	using Reg = __m256;
+	using Acc = __m256;
+
+	static constexpr std::size_t width = 8;
+	static constexpr bool hasDot = true;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm256_loadu_ps(data); }
+	static Reg broadcast(Type value) { return _mm256_set1_ps(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm256_min_ps(lhs, rhs); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm256_max_ps(lhs, rhs); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ))); }
+
+	static Acc accZero() { return _mm256_setzero_ps(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm256_add_ps(acc, value); }
+	static Acc accDot(Acc acc, Reg lhs, Reg rhs) { return _mm256_add_ps(acc, _mm256_mul_ps(lhs, rhs)); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm256_add_ps(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return lhs + rhs; }
+
+	static SumType accReduce(Acc acc)
+	{
+		return SimdSse2Ops<float>::accReduce(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		return SimdSse2Ops<float>::reduceMin(_mm_min_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)));
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		return SimdSse2Ops<float>::reduceMax(_mm_max_ps(_mm256_castps256_ps128(value), _mm256_extractf128_ps(value, 1)));
+	}
+};
+
+template <>
+struct SimdAvx2Ops<double>
+{
+	using Type = double;
+	using SumType = double;
+	using Reg = __m256d;
+	using Acc = __m256d;
+
+	static constexpr std::size_t width = 4;
+	static constexpr bool hasDot = true;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm256_loadu_pd(data); }
+	static Reg broadcast(Type value) { return _mm256_set1_pd(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm256_min_pd(lhs, rhs); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm256_max_pd(lhs, rhs); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ))); }
+
+	static Acc accZero() { return _mm256_setzero_pd(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm256_add_pd(acc, value); }
+	static Acc accDot(Acc acc, Reg lhs, Reg rhs) { return _mm256_add_pd(acc, _mm256_mul_pd(lhs, rhs)); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm256_add_pd(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return lhs + rhs; }
+
+	static SumType accReduce(Acc acc)
+	{
+		return SimdSse2Ops<double>::accReduce(_mm_add_pd(_mm256_castpd256_pd128(acc), _mm256_extractf128_pd(acc, 1)));
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		return SimdSse2Ops<double>::reduceMin(_mm_min_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1)));
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		return SimdSse2Ops<double>::reduceMax(_mm_max_pd(_mm256_castpd256_pd128(value), _mm256_extractf128_pd(value, 1)));
+	}
+};
+
+template <>
+struct SimdAvx2Ops<std::int32_t>
+{
+	using Type = std::int32_t;
+	using SumType = std::int64_t;
+	using Reg = __m256i;
+	using Acc = __m256i;
+
+	static constexpr std::size_t width = 8;
+	static constexpr bool hasDot = true;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+	static Reg broadcast(Type value) { return _mm256_set1_epi32(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm256_min_epi32(lhs, rhs); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm256_max_epi32(lhs, rhs); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs)))); }
+
+	static Acc accZero() { return _mm256_setzero_si256(); }
+
+	static Acc accAdd(Acc acc, Reg value)
+	{
+		acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(value)));
+		return _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(value, 1)));
+	}
+
+	static Acc accDot(Acc acc, Reg lhs, Reg rhs)
+	{
+		// mul_epi32 multiplies the even lanes into 64 bit products, the shift brings the odd ones down
+		acc = _mm256_add_epi64(acc, _mm256_mul_epi32(lhs, rhs));
+		return _mm256_add_epi64(acc, _mm256_mul_epi32(_mm256_srli_epi64(lhs, 32), _mm256_srli_epi64(rhs, 32)));
+	}
+
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm256_add_epi64(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return SimdScalarAdd<SumType>::add(lhs, rhs); }
+
+	static SumType accReduce(Acc acc)
+	{
+		return SimdSse2Ops<std::int64_t>::accReduce(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		return SimdSse2Ops<std::int32_t>::reduceMin(_mm_min_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1)));
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		return SimdSse2Ops<std::int32_t>::reduceMax(_mm_max_epi32(_mm256_castsi256_si128(value), _mm256_extracti128_si256(value, 1)));
+	}
+};
+
+template <>
+struct SimdAvx2Ops<std::int64_t>
+{
+	using Type = std::int64_t;
+	using SumType = std::int64_t;
+	using Reg = __m256i;
+	using Acc = __m256i;
+
+	static constexpr std::size_t width = 4;
+	// There is no 64 bit multiply before AVX-512
+	static constexpr bool hasDot = false;
+	static constexpr bool hasMinMax = true;
+
+	static Reg load(const Type* data) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data)); }
+	static Reg broadcast(Type value) { return _mm256_set1_epi64x(value); }
+	static Reg min(Reg lhs, Reg rhs) { return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs)); }
+	static Reg max(Reg lhs, Reg rhs) { return _mm256_blendv_epi8(rhs, lhs, _mm256_cmpgt_epi64(lhs, rhs)); }
+	static unsigned equalMask(Reg lhs, Reg rhs) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs)))); }
+
+	static Acc accZero() { return _mm256_setzero_si256(); }
+	static Acc accAdd(Acc acc, Reg value) { return _mm256_add_epi64(acc, value); }
+	static Acc accMerge(Acc lhs, Acc rhs) { return _mm256_add_epi64(lhs, rhs); }
+	static SumType scalarAdd(SumType lhs, SumType rhs) { return SimdScalarAdd<SumType>::add(lhs, rhs); }
+
+	static SumType accReduce(Acc acc)
+	{
+		return SimdSse2Ops<std::int64_t>::accReduce(_mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1)));
+	}
+
+	static Type reduceMin(Reg value)
+	{
+		alignas(32) std::int64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = lanes[i] < result ? lanes[i] : result;
+
+		return result;
+	}
+
+	static Type reduceMax(Reg value)
+	{
+		alignas(32) std::int64_t lanes[4];
+		_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value);
+
+		Type result = lanes[0];
+		for (std::size_t i = 1; i < width; ++i)
+			result = result < lanes[i] ? lanes[i] : result;
+
+		return result;
+	}
+};
+
+#define SIMD_LOOPS SimdAvx2Loops
+#include "SimdLoops.inl"
+#undef SIMD_LOOPS
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif // VECTOR_SIMD_X86
+
+// The entry point Vector uses. supported is false for every other type and then nothing here may be called
+template <typename Type>
+struct SimdKernels
+{
+	static constexpr bool supported =
+		std::is_same<Type, float>::value || std::is_same<Type, double>::value ||
+		std::is_same<Type, std::int32_t>::value || std::is_same<Type, std::int64_t>::value;
+
+	using SumType = std::conditional_t<std::is_integral<Type>::value && supported, std::int64_t, Type>;
+
+	static SumType sum(const Type* data, std::size_t size)
+	{
+#ifdef VECTOR_SIMD_X86
+		if (simdHasAvx2())
+			return SimdAvx2Loops<SimdAvx2Ops<Type>>::sum(data, size);
+
+		return SimdSse2Loops<SimdSse2Ops<Type>>::sum(data, size);
+#else
+		SumType result = SumType();
+
+		for (std::size_t i = 0; i < size; ++i)
+			result = SimdScalarAdd<SumType>::add(result, data[i]);
+
+		return result;
+#endif
+	}
+
+	static SumType dot(const Type* lhs, const Type* rhs, std::size_t size)
+	{
+#ifdef VECTOR_SIMD_X86
+		if constexpr (SimdAvx2Ops<Type>::hasDot)
+		{
+			if (simdHasAvx2())
+				return SimdAvx2Loops<SimdAvx2Ops<Type>>::dot(lhs, rhs, size);
+		}
+
+		if constexpr (SimdSse2Ops<Type>::hasDot)
+			return SimdSse2Loops<SimdSse2Ops<Type>>::dot(lhs, rhs, size);
+#endif
+		SumType result = SumType();
+
+		for (std::size_t i = 0; i < size; ++i)
+			result = SimdScalarAdd<SumType>::add(result, multiply(lhs[i], rhs[i]));
+
+		return result;
+	}
+
+	static Type min(const Type* data, std::size_t size)
+	{
+#ifdef VECTOR_SIMD_X86
+		if (simdHasAvx2())
+			return SimdAvx2Loops<SimdAvx2Ops<Type>>::min(data, size);
+
+		if constexpr (SimdSse2Ops<Type>::hasMinMax)
+			return SimdSse2Loops<SimdSse2Ops<Type>>::min(data, size);
+#endif
+		Type result = data[0];
+
+		for (std::size_t i = 1; i < size; ++i)
+			result = data[i] < result ? data[i] : result;
+
+		return result;
+	}
+
+	static Type max(const Type* data, std::size_t size)
+	{
+#ifdef VECTOR_SIMD_X86
+		if (simdHasAvx2())
+			return SimdAvx2Loops<SimdAvx2Ops<Type>>::max(data, size);
+
+		if constexpr (SimdSse2Ops<Type>::hasMinMax)
+			return SimdSse2Loops<SimdSse2Ops<Type>>::max(data, size);
+#endif
+		Type result = data[0];
+
+		for (std::size_t i = 1; i < size; ++i)
+			result = result < data[i] ? data[i] : result;
+
+		return result;
+	}
+
+	static std::size_t count(const Type* data, std::size_t size, Type value)
+	{
+#ifdef VECTOR_SIMD_X86
+		if (simdHasAvx2())
+			return SimdAvx2Loops<SimdAvx2Ops<Type>>::count(data, size, value);
+
+		return SimdSse2Loops<SimdSse2Ops<Type>>::count(data, size, value);
+#else
+		std::size_t result = 0;
+
+		for (std::size_t i = 0; i < size; ++i)
+			result += data[i] == value;
+
+		return result;
+#endif
+	}
+
+	static std::size_t find(const Type* data, std::size_t size, Type value)
+	{
+#ifdef VECTOR_SIMD_X86
+		if (simdHasAvx2())
+			return SimdAvx2Loops<SimdAvx2Ops<Type>>::find(data, size, value);
+
+		return SimdSse2Loops<SimdSse2Ops<Type>>::find(data, size, value);
+#else
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (data[i] == value)
+				return i;
+		}
+
+		return size;
+#endif
+	}
+
+private:
+	static SumType multiply(Type lhs, Type rhs)
+	{
+		if constexpr (std::is_integral<Type>::value)
+			return static_cast<SumType>(static_cast<std::uint64_t>(lhs) * static_cast<std::uint64_t>(rhs));
+		else
+			return lhs * rhs;
+	}
+};
+
+#endif // !SIMD_KERNELS_H
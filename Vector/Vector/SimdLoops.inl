@@ -0,0 +1,162 @@
+// The loops behind SimdKernels, written once against an Ops struct that wraps one instruction set.
+// SimdKernels.h includes this file once per instruction set with SIMD_LOOPS set to the struct name,
+// so every copy gets compiled with the target options of the place it was included from.
+
+#ifndef SIMD_LOOPS
+#error "Define SIMD_LOOPS before including SimdLoops.inl"
+#endif
+
+template <typename Ops>
+struct SIMD_LOOPS
+{
+	using Type = typename Ops::Type;
+	using SumType = typename Ops::SumType;
+	using Reg = typename Ops::Reg;
+	using Acc = typename Ops::Acc;
+
+	static constexpr std::size_t width = Ops::width;
+
+	static SumType sum(const Type* data, std::size_t size)
+	{
+		// Two accumulators hide the latency of the adds
+		Acc first = Ops::accZero();
+		Acc second = Ops::accZero();
+		std::size_t i = 0;
+
+		for (; i + 2 * width <= size; i += 2 * width)
+		{
+			first = Ops::accAdd(first, Ops::load(data + i));
+			second = Ops::accAdd(second, Ops::load(data + i + width));
+		}
+
+		for (; i + width <= size; i += width)
+			first = Ops::accAdd(first, Ops::load(data + i));
+
+		SumType result = Ops::accReduce(Ops::accMerge(first, second));
+
+		for (; i < size; ++i)
+			result = Ops::scalarAdd(result, data[i]);
+
+		return result;
+	}
+
+	static SumType dot(const Type* lhs, const Type* rhs, std::size_t size)
+	{
+		Acc first = Ops::accZero();
+		Acc second = Ops::accZero();
+		std::size_t i = 0;
+
+		for (; i + 2 * width <= size; i += 2 * width)
+		{
+			first = Ops::accDot(first, Ops::load(lhs + i), Ops::load(rhs + i));
+			second = Ops::accDot(second, Ops::load(lhs + i + width), Ops::load(rhs + i + width));
+		}
+
+		for (; i + width <= size; i += width)
+			first = Ops::accDot(first, Ops::load(lhs + i), Ops::load(rhs + i));
+
+		SumType result = Ops::accReduce(Ops::accMerge(first, second));
+
+		for (; i < size; ++i)
+			result = Ops::scalarAdd(result, static_cast<SumType>(lhs[i]) * rhs[i]);
+
+		return result;
+	}
+
+	// Both expect at least one element
+	static Type min(const Type* data, std::size_t size)
+	{
+		if (size < width)
+			return scalarMin(data, size);
+
+		Reg best = Ops::load(data);
+		std::size_t i = width;
+
+		for (; i + width <= size; i += width)
+			best = Ops::min(best, Ops::load(data + i));
+
+		Type result = Ops::reduceMin(best);
+
+		for (; i < size; ++i)
+			result = data[i] < result ? data[i] : result;
+
+		return result;
+	}
+
+	static Type max(const Type* data, std::size_t size)
+	{
+		if (size < width)
+			return scalarMax(data, size);
+
+		Reg best = Ops::load(data);
+		std::size_t i = width;
+
+		for (; i + width <= size; i += width)
+			best = Ops::max(best, Ops::load(data + i));
+
+		Type result = Ops::reduceMax(best);
+
+		for (; i < size; ++i)
+			result = result < data[i] ? data[i] : result;
+
+		return result;
+	}
+
+	static std::size_t count(const Type* data, std::size_t size, Type value)
+	{
+		Reg target = Ops::broadcast(value);
+		std::size_t result = 0;
+		std::size_t i = 0;
+
+		for (; i + width <= size; i += width)
+			result += simdPopCount(Ops::equalMask(Ops::load(data + i), target));
+
+		for (; i < size; ++i)
+			result += data[i] == value;
+
+		return result;
+	}
+
+	static std::size_t find(const Type* data, std::size_t size, Type value)
+	{
+		Reg target = Ops::broadcast(value);
+		std::size_t i = 0;
+
+		for (; i + width <= size; i += width)
+		{
+			unsigned mask = Ops::equalMask(Ops::load(data + i), target);
+
+			if (mask)
+				return i + simdLowestBit(mask);
+		}
+
+		for (; i < size; ++i)
+		{
+			if (data[i] == value)
+				return i;
+		}
+
+		return size;
+	}
+
+private:
+	static Type scalarMin(const Type* data, std::size_t size)
+	{
+		Type result = data[0];
+
+		for (std::size_t i = 1; i < size; ++i)
+			result = data[i] < result ? data[i] : result;
+
+		return result;
+	}
+
+	static Type scalarMax(const Type* data, std::size_t size)
+	{
+		Type result = data[0];
+
+		for (std::size_t i = 1; i < size; ++i)
+			result = result < data[i] ? data[i] : result;
+
+		return result;
+	}
+};
@@ -0,0 +1,12 @@
+#ifndef SMALL_VECTOR_H
+
+#define SMALL_VECTOR_H
+
+#include "Vector.h"
+
+// A Vector that keeps up to N elements inside itself and goes to the heap only when it outgrows them.
+// Copying or moving a small one copies / moves the elements, a spilled one is moved by stealing its buffer.
+template <typename Type, std::size_t N, typename GrowthPolicy = GeometricGrowth<>, typename Allocator = std::allocator<Type>>
+using SmallVector = Vector<Type, GrowthPolicy, Allocator, N>;
+
+#endif // !SMALL_VECTOR_H
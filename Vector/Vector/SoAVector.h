@@ -0,0 +1,300 @@
+#ifndef SOA_VECTOR_H
+
+#define SOA_VECTOR_H
+
+#include "Vector.h"
+
+#include <stdexcept>
+#include <cstddef>
+#include <utility>
+#include <tuple>
+
+// A contiguous run of one column of a SoAVector. Only valid until the SoAVector grows
+template <typename Type>
+class ColumnSpan
+{
+public:
+	ColumnSpan(Type* data, std::size_t size) : m_Data(data), m_Size(size) {}
+
+	Type& operator[] (std::size_t index) const { return m_Data[index]; }
+
+	Type* begin() const { return m_Data; }
+	Type* end() const { return m_Data + m_Size; }
+
+	Type* data() const { return m_Data; }
+	std::size_t size() const { return m_Size; }
+	bool empty() const { return m_Size == 0; }
+
+private:
+	Type* m_Data;
+	std::size_t m_Size;
+};
+
+// Structure of arrays: row i is (column<0>()[i], column<1>()[i], ...), every column is its own Vector.
+// A scan over one field only reads that field's memory, and the columns can be handed to SIMD loops as they are.
+// All the columns always have the same size.
+template <typename... Ts>
+class SoAVector
+{
+	static_assert(sizeof...(Ts) > 0, "A SoAVector needs at least one column");
+
+	template <std::size_t I>
+	using ColumnType = typename std::tuple_element<I, std::tuple<Ts...>>::type;
+
+public:
+	using size_type = std::size_t;
+	using value_type = std::tuple<Ts...>;
+
+	// A reference to one row. It stays valid while the SoAVector does not grow or shrink
+	template <bool Const>
+	class RowProxy
+	{
+	public:
+		using Owner = typename std::conditional<Const, const SoAVector, SoAVector>::type;
+
+		RowProxy(Owner& owner, size_type index) : m_Owner(&owner), m_Index(index) {}
+
+		template <std::size_t I>
+		typename std::conditional<Const, const ColumnType<I>&, ColumnType<I>&>::type get() const
+		{
+			return m_Owner->template column<I>()[m_Index];
+		}
+
+		// Copies the whole row out
+		operator value_type() const
+		{
+			return toTuple(std::index_sequence_for<Ts...>());
+		}
+
+	private:
+		Owner* m_Owner;
+		size_type m_Index;
+
+		template <std::size_t... Is>
+		value_type toTuple(std::index_sequence<Is...>) const
+		{
+			return value_type(get<Is>()...);
+		}
+	};
+
+	using Row = RowProxy<false>;
+	using ConstRow = RowProxy<true>;
+
+	Row operator[] (size_type index);
+	ConstRow operator[] (size_type index) const;
+
+	Row at(size_type index);
+	ConstRow at(size_type index) const;
+
+	template <std::size_t I>
+	ColumnSpan<ColumnType<I>> column();
+	template <std::size_t I>
+	ColumnSpan<const ColumnType<I>> column() const;
+
+	size_type size() const;
+	size_type capacity() const;
+	bool empty() const;
+
+	void reserve(size_type newCapacity);
+	void shrinkToFit();
+	void resize(size_type newSize);
+
+	void clear();
+	void pushBack(Ts... values);
+	void popBack();
+	void erase(size_type index);
+	void swapErase(size_type index);
+
+private:
+	std::tuple<Vector<Ts>...> m_Columns;
+
+	template <typename Func, std::size_t... Is>
+	void forEachColumn(Func func, std::index_sequence<Is...>);
+	template <typename Func>
+	void forEachColumn(Func func);
+
+	template <std::size_t I, typename Value, typename... Rest>
+	void pushColumns(Value&& value, Rest&&... rest);
+	template <std::size_t I>
+	void pushColumns();
+};
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::Row SoAVector<Ts...>::operator[] (size_type index)
+{
+	return Row(*this, index);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::ConstRow SoAVector<Ts...>::operator[] (size_type index) const
+{
+	return ConstRow(*this, index);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::Row SoAVector<Ts...>::at(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	return Row(*this, index);
+}
+
+template<typename... Ts>
+inline typename SoAVector<Ts...>::ConstRow SoAVector<Ts...>::at(size_type index) const
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	return ConstRow(*this, index);
+}
+
+template<typename... Ts>
+template<std::size_t I>
+inline ColumnSpan<typename SoAVector<Ts...>::template ColumnType<I>> SoAVector<Ts...>::column()
+{
+	Vector<ColumnType<I>>& column = std::get<I>(m_Columns);
+	return ColumnSpan<ColumnType<I>>(column.data(), column.size());
+}
+
+template<typename... Ts>
+template<std::size_t I>
+inline ColumnSpan<const typename SoAVector<Ts...>::template ColumnType<I>> SoAVector<Ts...>::column() const
+{
+	const Vector<ColumnType<I>>& column = std::get<I>(m_Columns);
+	return ColumnSpan<const ColumnType<I>>(column.data(), column.size());
+}
+
+template<typename... Ts>
+inline std::size_t SoAVector<Ts...>::size() const
+{
+	return std::get<0>(m_Columns).size();
+}
+
+template<typename... Ts>
+inline std::size_t SoAVector<Ts...>::capacity() const
+{
+	return std::get<0>(m_Columns).capacity();
+}
+
+template<typename... Ts>
+inline bool SoAVector<Ts...>::empty() const
+{
+	return size() == 0;
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::reserve(size_type newCapacity)
+{
+	forEachColumn([&](auto& column) { column.reserve(newCapacity); });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::shrinkToFit()
+{
+	forEachColumn([](auto& column) { column.shrinkToFit(); });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::resize(size_type newSize)
+{
+	size_type oldSize = size();
+
+	// Reserving first leaves only the element constructors to fail half way
+	reserve(newSize);
+
+	try
+	{
+		forEachColumn([&](auto& column) { column.resize(newSize); });
+	}
+	catch (...)
+	{
+		forEachColumn([&](auto& column)
+		{
+			if (column.size() > oldSize)
+				column.resize(oldSize);
+		});
+
+		throw;
+	}
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::clear()
+{
+	forEachColumn([](auto& column) { column.clear(); });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::pushBack(Ts... values)
+{
+	pushColumns<0>(std::move(values)...);
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::popBack()
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	forEachColumn([](auto& column) { column.popBack(); });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::erase(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	forEachColumn([&](auto& column) { column.erase(index); });
+}
+
+template<typename... Ts>
+inline void SoAVector<Ts...>::swapErase(size_type index)
+{
+	if (index >= size())
+		throw std::out_of_range("Index is out of range!");
+
+	forEachColumn([&](auto& column) { column.swapErase(index); });
+}
+
+template<typename... Ts>
+template<typename Func, std::size_t... Is>
+inline void SoAVector<Ts...>::forEachColumn(Func func, std::index_sequence<Is...>)
+{
+	(func(std::get<Is>(m_Columns)), ...);
+}
+
+template<typename... Ts>
+template<typename Func>
+inline void SoAVector<Ts...>::forEachColumn(Func func)
+{
+	forEachColumn(func, std::index_sequence_for<Ts...>());
+}
+
+template<typename... Ts>
+template<std::size_t I, typename Value, typename... Rest>
+inline void SoAVector<Ts...>::pushColumns(Value&& value, Rest&&... rest)
+{
+	Vector<ColumnType<I>>& column = std::get<I>(m_Columns);
+	column.pushBack(std::forward<Value>(value));
+
+	// If a later column throws, this one gives its new element back so the sizes stay equal
+	try
+	{
+		pushColumns<I + 1>(std::forward<Rest>(rest)...);
+	}
+	catch (...)
+	{
+		column.popBack();
+		throw;
+	}
+}
+
+template<typename... Ts>
+template<std::size_t I>
+inline void SoAVector<Ts...>::pushColumns()
+{
+}
+
+#endif // !SOA_VECTOR_H
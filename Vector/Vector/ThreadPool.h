@@ -0,0 +1,166 @@
+#ifndef THREAD_POOL_H
+
+#define THREAD_POOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+// A fixed set of worker threads. parallelFor is the only way work gets in,
+// the calling thread helps out, so nested calls from inside a task can not deadlock.
+class ThreadPool
+{
+public:
+	explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+	ThreadPool(const ThreadPool& other) = delete;
+	~ThreadPool();
+
+	ThreadPool& operator= (const ThreadPool& other) = delete;
+
+	// Counts the calling thread too
+	std::size_t size() const;
+
+	// Calls task(i) for every i in [0, count) and returns once all of them are done.
+	// The first exception thrown by a task is rethrown here
+	template <typename Task>
+	void parallelFor(std::size_t count, Task task);
+
+	// One pool for the whole process, sized to the hardware
+	static ThreadPool& shared();
+
+private:
+	std::vector<std::thread> m_Workers;
+	std::queue<std::function<void()>> m_Jobs;
+	std::mutex m_Mutex;
+	std::condition_variable m_HasJobs;
+	bool m_Stopping;
+
+	void work();
+};
+
+inline ThreadPool::ThreadPool(std::size_t threads)
+	: m_Stopping(false)
+{
+	for (std::size_t i = 1; i < threads; ++i)
+		m_Workers.emplace_back([this]() { work(); });
+}
+
+inline ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Stopping = true;
+	}
+
+	m_HasJobs.notify_all();
+
+	for (std::thread& worker : m_Workers)
+		worker.join();
+}
+
+inline std::size_t ThreadPool::size() const
+{
+	return m_Workers.size() + 1;
+}
+
+template <typename Task>
+inline void ThreadPool::parallelFor(std::size_t count, Task task)
+{
+	if (count == 0)
+		return;
+
+	struct State
+	{
+		std::atomic<std::size_t> next{ 0 };
+		std::atomic<std::size_t> done{ 0 };
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr error;
+	};
+
+	// Helpers may wake up after everything is done, so they keep the state alive themselves.
+	// They only touch the task while there are unclaimed indices, and then the caller is still waiting
+	auto state = std::make_shared<State>();
+	Task* taskPtr = &task;
+
+	auto run = [state, taskPtr, count]()
+	{
+		for (std::size_t i = state->next++; i < count; i = state->next++)
+		{
+			try
+			{
+				(*taskPtr)(i);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+
+				if (!state->error)
+					state->error = std::current_exception();
+			}
+
+			if (++state->done == count)
+			{
+				std::lock_guard<std::mutex> lock(state->mutex);
+				state->finished.notify_all();
+			}
+		}
+	};
+
+	std::size_t helpers = count - 1 < m_Workers.size() ? count - 1 : m_Workers.size();
+
+	if (helpers > 0)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			for (std::size_t i = 0; i < helpers; ++i)
+				m_Jobs.push(run);
+		}
+
+		m_HasJobs.notify_all();
+	}
+
+	run();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&]() { return state->done == count; });
+
+	if (state->error)
+		std::rethrow_exception(state->error);
+}
+
+inline ThreadPool& ThreadPool::shared()
+{
+	static ThreadPool pool;
+	return pool;
+}
+
+inline void ThreadPool::work()
+{
+	for (;;)
+	{
+		std::function<void()> job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_HasJobs.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+
+			if (m_Jobs.empty())
+				return;
+
+			job = std::move(m_Jobs.front());
+			m_Jobs.pop();
+		}
+
+		job();
+	}
+}
+
+#endif // !THREAD_POOL_H
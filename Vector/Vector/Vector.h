@@ -2,16 +2,104 @@
 
 #define VECTOR_H
 
+#include "GrowthPolicy.h"
+#include "InlineStorage.h"
+#include "SimdKernels.h"
+#include "VectorSort.h"
+#include "RadixSort.h"
+#include "VectorFormat.h"
+#include "VectorStats.h"
+
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <iterator>
+#include <functional>
+#include <memory>
+#include <new>
+#include <istream>
+#include <ostream>
 
 // Too lazy to make a seperate .inl file lol
 
-template <typename Type>
-class Vector
+// Keeps the allocator without taking any space when it is stateless (std::allocator)
+template <typename Allocator, bool = std::is_empty<Allocator>::value && !std::is_final<Allocator>::value>
+struct AllocatorHolder : private Allocator
+{
+	AllocatorHolder() = default;
+	AllocatorHolder(const Allocator& allocator) : Allocator(allocator) {}
+
+	Allocator& allocator() { return *this; }
+	const Allocator& allocator() const { return *this; }
+};
+
+template <typename Allocator>
+struct AllocatorHolder<Allocator, false>
+{
+	AllocatorHolder() = default;
+	AllocatorHolder(const Allocator& allocator) : m_Allocator(allocator) {}
+
+	Allocator& allocator() { return m_Allocator; }
+	const Allocator& allocator() const { return m_Allocator; }
+
+private:
+	Allocator m_Allocator;
+};
+
+// What Vector::storageInfo reports about the current buffer
+struct VectorStorageInfo
+{
+	// The biggest power of two the buffer's address is a multiple of, 0 when there is no buffer
+	std::size_t alignment;
+	bool isInline;
+	bool hugePages;
+};
+
+// Allocators that can tell whether a buffer got huge pages have usesHugePages(data, count) (see AlignedAllocator.h)
+template <typename Allocator, typename = void>
+struct ReportsHugePages : std::false_type {};
+
+template <typename Allocator>
+struct ReportsHugePages<Allocator, std::void_t<decltype(std::declval<const Allocator&>().usesHugePages(std::declval<typename Allocator::value_type*>(), std::size_t()))>> : std::true_type {};
+
+// MSVC gives only the first empty base no space unless the class asks for it on all of them
+#if defined(_MSC_VER)
+#define VECTOR_EMPTY_BASES __declspec(empty_bases)
+#else
+#define VECTOR_EMPTY_BASES
+#endif
+
+// InlineCapacity elements live inside the object itself, the heap is used only beyond that (see SmallVector.h)
+template <typename Type, typename GrowthPolicy = GeometricGrowth<>, typename Allocator = std::allocator<Type>, std::size_t InlineCapacity = 0>
+class VECTOR_EMPTY_BASES Vector : private InlineStorage<Type, InlineCapacity>, private AllocatorHolder<Allocator>, private VectorStatsHolder
 {
+	using AllocatorTraits = std::allocator_traits<Allocator>;
+
+	static_assert(std::is_same<typename AllocatorTraits::value_type, Type>::value, "The allocator must allocate Type!");
+
 public:
+	using value_type		= Type;
+	using allocator_type	= Allocator;
+	using size_type			= std::size_t;
+	using difference_type	= std::ptrdiff_t;
+	using reference			= Type&;
+	using const_reference	= const Type&;
+	using pointer			= Type*;
+	using const_pointer		= const Type*;
+	using sum_type			= typename SimdKernels<Type>::SumType;
+
+	// Plain pointers, so loops over a Vector compile to the same code as loops over an array
+	using iterator					= Type*;
+	using const_iterator			= const Type*;
+	using reverse_iterator			= std::reverse_iterator<iterator>;
+	using const_reverse_iterator	= std::reverse_iterator<const_iterator>;
+
 	Vector();
-	Vector(const Type* data, const int& dataSize);
+	explicit Vector(const Allocator& allocator);
+	Vector(const Type* data, size_type dataSize, const Allocator& allocator = Allocator());
 	Vector(const Vector& other);
 	Vector(Vector&& other) noexcept;
 	~Vector();
@@ -19,321 +107,1314 @@ public:
 	Vector& operator= (const Vector& other);
 	Vector& operator= (Vector&& other) noexcept;
 
-	Type& operator[] (const int& index);
-	const Type& operator[] (const int& index) const;
+	Type& operator[] (size_type index);
+	const Type& operator[] (size_type index) const;
 
-	Type& at(const int& index);
-	const Type& at(const int& index) const;
+	iterator begin();
+	iterator end();
+	const_iterator begin() const;
+	const_iterator end() const;
+	const_iterator cbegin() const;
+	const_iterator cend() const;
+
+	reverse_iterator rbegin();
+	reverse_iterator rend();
+	const_reverse_iterator rbegin() const;
+	const_reverse_iterator rend() const;
+	const_reverse_iterator crbegin() const;
+	const_reverse_iterator crend() const;
+
+	Type& at(size_type index);
+	const Type& at(size_type index) const;
 
 	Type& back();
 	Type& front();
 	const Type& back() const;
 	const Type& front() const;
 
+	Type* data();
 	const Type* data() const;
-	int size() const;
-	int capacity() const;
+	Allocator getAllocator() const;
+	VectorStorageInfo storageInfo() const;
+	size_type size() const;
+	size_type capacity() const;
 	bool empty() const;
+	// What this vector has allocated, copied and moved so far. All zeros unless VECTOR_STATS is defined (see VectorStats.h)
+	using VectorStatsHolder::stats;
+
+	// std::length_error when newCapacity is more than the allocator can hand out
+	void reserve(size_type newCapacity);
+	void shrinkToFit();
+	void resize(size_type newSize);
+	void resize(size_type newSize, const Type& value);
 
 	void clear();
-	void insert(const Type* data, const int& dataSize);
-	void erase(int index);
-	void erase(int first, int last);
+	void insert(const Type* data, size_type dataSize);
+	void insert(size_type position, size_type count, const Type& value);
+	template <typename ForwardIt, typename = std::enable_if_t<!std::is_integral<ForwardIt>::value>>
+	void insert(size_type position, ForwardIt first, ForwardIt last);
+	void erase(size_type index);
+	void erase(size_type first, size_type last);
+	// Both compact the vector in a single pass and return how many elements were removed
+	size_type remove(const Type& value);
+	template <typename Predicate>
+	size_type removeIf(Predicate predicate);
+	// O(1), the last element takes the place of the erased one
+	void swapErase(size_type index);
 	void pushBack(const Type& el);
+	void pushBack(Type&& el);
+	template <typename... Args>
+	Type& emplaceBack(Args&&... args);
 	void popBack();
 
+	// Vectorized for float, double, int32_t and int64_t (see SimdKernels.h), plain loops for everything else
+	sum_type sum() const;
+	sum_type dot(const Vector& other) const;
+	const Type& minElement() const;
+	const Type& maxElement() const;
+	size_type argMin() const;
+	size_type argMax() const;
+	size_type count(const Type& value) const;
+	// Returns size() when the value is missing
+	size_type find(const Type& value) const;
+
+	// Big vectors are sorted on all cores (see VectorSort.h), small ones with an introsort
+	void sort();
+	template <typename Compare>
+	void sort(Compare comp);
+
+	// Stable sort in one pass per key byte (see RadixSort.h), for integral and floating point keys.
+	// The overloads without a scratch reuse one kept for the calling thread, or a temporary one
+	// for vectors over RadixScratch::LOCAL_LIMIT bytes
+	void radixSort();
+	void radixSort(RadixScratch& scratch);
+	template <typename KeyOf>
+	void radixSort(KeyOf keyOf);
+	template <typename KeyOf>
+	void radixSort(KeyOf keyOf, RadixScratch& scratch);
+
+	// Whole buffer reads / writes in the VectorFormat.h layout, which a VectorView can use in place.
+	// Trivially copyable elements only. readFrom throws std::runtime_error on a bad or short stream
+	// and keeps the old contents then
+	void writeTo(std::ostream& stream) const;
+	void readFrom(std::istream& stream);
+
 private:
 	Type* m_Data;
-	int m_Size;
-	int m_Capacity;
+	size_type m_Size;
+	size_type m_Capacity;
 
-	int calculateCapacity(const int& num);
-	void resize(const int& newSize);
+	size_type calculateCapacity(size_type newSize);
+	void reallocate(size_type newCapacity);
+	// No value means value initialization, so only the constructor that is used has to exist
+	template <typename... Value>
+	void resizeTo(size_type newSize, const Value&... value);
 
 	void freeMemory();
 	void copy(const Vector& other);
-	void swap(Vector& other);
+	void steal(Vector& other);
+	bool isInline() const;
+
+	// The buffer is raw memory, only the first m_Size slots hold constructed objects
+	Type* allocate(size_type capacity);
+	void deallocate(Type* data, size_type capacity);
+	static void destroy(Type* first, Type* last);
+	static void copyElements(const Type* source, size_type count, Type* dest);
+	template <typename... Value>
+	static void fillElements(Type* dest, size_type count, const Value&... value);
+	static void relocate(Type* source, size_type count, Type* dest);
+	void moveElements(Type* dest);
+	void countRelocation(size_type count);
+	template <typename... Args>
+	void countCopiesFrom(size_type count);
+	template <typename Next>
+	void insertN(size_type position, size_type count, Next next);
+	bool isInside(const Type* ptr) const;
+
+	// Trivially copyable elements are copied and shifted with memcpy / memmove instead of one by one
+	static constexpr bool isTrivial = std::is_trivially_copyable<Type>::value;
 };
 
-template<typename Type>
-inline Vector<Type>::Vector()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::Vector()
 {
 	m_Size = 0;
-	m_Capacity = 0;
-	m_Data = nullptr;
+	m_Capacity = InlineCapacity;
+	m_Data = this->inlineData();
 }
 
-template<typename Type>
-inline Vector<Type>::Vector(const Type* data, const int& dataSize)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::Vector(const Allocator& allocator)
+	: AllocatorHolder<Allocator>(allocator)
 {
-	if (dataSize <= 0)
-		throw std::invalid_argument("The data's size can not be negative or zero!");
-
 	m_Size = 0;
-	m_Capacity = calculateCapacity(dataSize);
-	m_Data = new Type[m_Capacity];
+	m_Capacity = InlineCapacity;
+	m_Data = this->inlineData();
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::Vector(const Type* data, size_type dataSize, const Allocator& allocator)
+	: Vector(allocator)
+{
+	if (dataSize == 0)
+		throw std::invalid_argument("The data's size can not be zero!");
 
 	insert(data, dataSize);
 }
 
-template<typename Type>
-inline Vector<Type>::Vector(const Vector& other)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::Vector(const Vector& other)
+	: AllocatorHolder<Allocator>(AllocatorTraits::select_on_container_copy_construction(other.allocator()))
 {
 	copy(other);
 }
 
-template<typename Type>
-inline Vector<Type>::Vector(Vector&& other) noexcept
-	: Vector()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::Vector(Vector&& other) noexcept
+	: Vector(other.allocator())
 {
-	swap(other);
+	steal(other);
 }
 
-template<typename Type>
-inline Vector<Type>::~Vector()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::~Vector()
 {
 	freeMemory();
 }
 
-template<typename Type>
-inline Vector<Type>& Vector<Type>::operator=(const Vector& other)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::operator=(const Vector& other)
 {
 	if (this != &other)
 	{
 		freeMemory();
+
+		if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+			this->allocator() = other.allocator();
+
 		copy(other);
 	}
 
 	return *this;
 }
 
-template<typename Type>
-inline Vector<Type>& Vector<Type>::operator=(Vector<Type>&& other) noexcept
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Vector<Type, GrowthPolicy, Allocator, InlineCapacity>& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::operator=(Vector<Type, GrowthPolicy, Allocator, InlineCapacity>&& other) noexcept
 {
 	if (this != &other)
-		swap(other);
+	{
+		freeMemory();
+
+		m_Size = 0;
+		m_Capacity = InlineCapacity;
+		m_Data = this->inlineData();
+
+		if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+			this->allocator() = other.allocator();
+
+		steal(other);
+	}
 
 	return *this;
 }
 
-template<typename Type>
-inline Type& Vector<Type>::operator[](const int& index)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::operator[](size_type index)
 {
 	return m_Data[index];
 }
 
-template<typename Type>
-inline const Type& Vector<Type>::operator[](const int& index) const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::operator[](size_type index) const
 {
 	return m_Data[index];
 }
 
-template<typename Type>
-inline Type& Vector<Type>::at(const int& index)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::at(size_type index)
 {
-	if (index < 0 || index >= m_Size)
+	if (index >= m_Size)
 		throw std::out_of_range("Index out of range exception!");
 
 	return m_Data[index];
 }
 
-template<typename Type>
-inline const Type& Vector<Type>::at(const int& index) const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::at(size_type index) const
 {
-	if (index < 0 || index >= m_Size)
+	if (index >= m_Size)
 		throw std::out_of_range("Index out of range exception!");
 
 	return m_Data[index];
 }
 
-template<typename Type>
-inline Type& Vector<Type>::back()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::back()
 {
 	if (empty())
-		throw std::exception("The vector is empty!");
+		throw std::logic_error("The vector is empty!");
 
 	return m_Data[m_Size - 1];
 }
 
-template<typename Type>
-inline Type& Vector<Type>::front()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::front()
 {
 	if (empty())
-		throw std::exception("The vector is empty!");
+		throw std::logic_error("The vector is empty!");
 
 	return m_Data[0];
 }
 
-template<typename Type>
-inline const Type& Vector<Type>::back() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::back() const
 {
 	if (empty())
-		throw std::exception("The vector is empty!");
+		throw std::logic_error("The vector is empty!");
 
 	return m_Data[m_Size - 1];
 }
 
-template<typename Type>
-inline const Type& Vector<Type>::front() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::front() const
 {
 	if (empty())
-		throw std::exception("The vector is empty!");
+		throw std::logic_error("The vector is empty!");
 
 	return m_Data[0];
 }
 
-template<typename Type>
-inline const Type* Vector<Type>::data() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type* Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::data()
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type* Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::data() const
 {
 	return m_Data;
 }
 
-template<typename Type>
-inline int Vector<Type>::size() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::begin()
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::end()
+{
+	return m_Data + m_Size;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::begin() const
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::end() const
+{
+	return m_Data + m_Size;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::cbegin() const
+{
+	return m_Data;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::cend() const
+{
+	return m_Data + m_Size;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::rbegin()
+{
+	return reverse_iterator(end());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::rend()
+{
+	return reverse_iterator(begin());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::rbegin() const
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::rend() const
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::crbegin() const
+{
+	return const_reverse_iterator(end());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::const_reverse_iterator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::crend() const
+{
+	return const_reverse_iterator(begin());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Allocator Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::getAllocator() const
+{
+	return this->allocator();
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline VectorStorageInfo Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::storageInfo() const
+{
+	VectorStorageInfo info;
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(m_Data);
+
+	info.alignment = static_cast<std::size_t>(address & (~address + 1));
+	info.isInline = isInline();
+	info.hugePages = false;
+
+	if constexpr (ReportsHugePages<Allocator>::value)
+	{
+		if (m_Data && !info.isInline)
+			info.hugePages = this->allocator().usesHugePages(m_Data, m_Capacity);
+	}
+
+	return info;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::size() const
 {
 	return m_Size;
 }
 
-template<typename Type>
-inline int Vector<Type>::capacity() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::capacity() const
 {
 	return m_Capacity;
 }
 
-template<typename Type>
-inline bool Vector<Type>::empty() const
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline bool Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::empty() const
+{
+	return m_Size == 0;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::reserve(size_type newCapacity)
+{
+	if (newCapacity > AllocatorTraits::max_size(this->allocator()))
+		throw std::length_error("The capacity is too big for a vector!");
+
+	if (newCapacity > m_Capacity)
+		reallocate(newCapacity);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::shrinkToFit()
+{
+	if (m_Capacity > m_Size)
+		reallocate(m_Size);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::resize(size_type newSize)
+{
+	resizeTo(newSize);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::resize(size_type newSize, const Type& value)
 {
-	return m_Size <= 0;
+	resizeTo(newSize, value);
 }
 
-template<typename Type>
-inline void Vector<Type>::clear()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::clear()
 {
+	// Keeps the buffer so the vector can be refilled without allocating
+	destroy(m_Data, m_Data + m_Size);
 	m_Size = 0;
-	m_Capacity = 0;
-	freeMemory();
-	m_Data = nullptr;
 }
 
-template<typename Type>
-inline void Vector<Type>::insert(const Type* data, const int& dataSize)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::insert(const Type* data, size_type dataSize)
+{
+	insert(m_Size, data, data + dataSize);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::insert(size_type position, size_type count, const Type& value)
 {
-	for (int i = 0; i < dataSize; i++)
+	if (count == 0)
+		return;
+
+	// The value may be one of our own elements that is about to be shifted
+	if (isInside(&value) && &value >= m_Data + position)
+	{
+		Type copy(value);
+		this->countCopies(1);
+		insertN(position, count, [&]() -> const Type& { return copy; });
+		return;
+	}
+
+	insertN(position, count, [&]() -> const Type& { return value; });
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename ForwardIt, typename>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::insert(size_type position, ForwardIt first, ForwardIt last)
+{
+	size_type count = static_cast<size_type>(std::distance(first, last));
+
+	if (count == 0)
+		return;
+
+	if constexpr (std::is_pointer<ForwardIt>::value)
 	{
-		pushBack(data[i]);
+		// A range from our own tail would be shifted under our feet, so insert a copy of it instead
+		if (position < m_Size && isInside(&*first))
+		{
+			Vector copy(this->allocator());
+			copy.insert(0, first, last);
+			insertN(position, count, [&, i = 0]() mutable -> Type& { return copy[i++]; });
+			return;
+		}
 	}
+
+	insertN(position, count, [&]() -> decltype(auto) { return *first++; });
 }
 
-template<typename Type>
-inline void Vector<Type>::erase(int index)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::erase(size_type index)
 {
 	// Check if this index exists
 	at(index);
 
-	for (int i = index + 1; i < m_Size; ++i)
+	this->countMoves(m_Size - index - 1);
+
+	if constexpr (isTrivial)
+	{
+		std::memmove(m_Data + index, m_Data + index + 1, sizeof(Type) * (m_Size - index - 1));
+		m_Size--;
+		return;
+	}
+
+	for (size_type i = index + 1; i < m_Size; ++i)
+	{
+		m_Data[index++] = std::move(m_Data[i]);
+	}
+
+	m_Data[--m_Size].~Type();
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::sum_type Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::sum() const
+{
+	if constexpr (SimdKernels<Type>::supported)
+		return SimdKernels<Type>::sum(m_Data, m_Size);
+
+	sum_type result = sum_type();
+
+	for (size_type i = 0; i < m_Size; ++i)
+		result += m_Data[i];
+
+	return result;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline typename Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::sum_type Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::dot(const Vector& other) const
+{
+	if (m_Size != other.m_Size)
+		throw std::invalid_argument("The vectors must have the same size!");
+
+	if constexpr (SimdKernels<Type>::supported)
+		return SimdKernels<Type>::dot(m_Data, other.m_Data, m_Size);
+
+	sum_type result = sum_type();
+
+	for (size_type i = 0; i < m_Size; ++i)
+		result += m_Data[i] * other.m_Data[i];
+
+	return result;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::minElement() const
+{
+	return m_Data[argMin()];
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline const Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::maxElement() const
+{
+	return m_Data[argMax()];
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::argMin() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	if constexpr (SimdKernels<Type>::supported)
 	{
-		m_Data[index++] = m_Data[i];
+		// Find the value first, then where it is. Only a NaN can make the second pass miss
+		size_type index = SimdKernels<Type>::find(m_Data, m_Size, SimdKernels<Type>::min(m_Data, m_Size));
+
+		if (index < m_Size)
+			return index;
 	}
 
-	m_Size--;
+	size_type best = 0;
+
+	for (size_type i = 1; i < m_Size; ++i)
+	{
+		if (m_Data[i] < m_Data[best])
+			best = i;
+	}
+
+	return best;
 }
 
-template<typename Type>
-inline void Vector<Type>::erase(int first, int last)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::argMax() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	if constexpr (SimdKernels<Type>::supported)
+	{
+		size_type index = SimdKernels<Type>::find(m_Data, m_Size, SimdKernels<Type>::max(m_Data, m_Size));
+
+		if (index < m_Size)
+			return index;
+	}
+
+	size_type best = 0;
+
+	for (size_type i = 1; i < m_Size; ++i)
+	{
+		if (m_Data[best] < m_Data[i])
+			best = i;
+	}
+
+	return best;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::count(const Type& value) const
+{
+	if constexpr (SimdKernels<Type>::supported)
+		return SimdKernels<Type>::count(m_Data, m_Size, value);
+
+	size_type result = 0;
+
+	for (size_type i = 0; i < m_Size; ++i)
+	{
+		if (m_Data[i] == value)
+			result++;
+	}
+
+	return result;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::find(const Type& value) const
+{
+	if constexpr (SimdKernels<Type>::supported)
+		return SimdKernels<Type>::find(m_Data, m_Size, value);
+
+	for (size_type i = 0; i < m_Size; ++i)
+	{
+		if (m_Data[i] == value)
+			return i;
+	}
+
+	return m_Size;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::sort()
+{
+	sort([](const Type& lhs, const Type& rhs) { return lhs < rhs; });
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename Compare>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::sort(Compare comp)
+{
+	parallelSort(m_Data, m_Data + m_Size, comp);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::radixSort()
+{
+	radixSort([](const Type& el) { return el; });
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::radixSort(RadixScratch& scratch)
+{
+	radixSort([](const Type& el) { return el; }, scratch);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename KeyOf>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::radixSort(KeyOf keyOf)
+{
+	if (sizeof(Type) * m_Size > RadixScratch::LOCAL_LIMIT)
+	{
+		RadixScratch scratch;
+		radixSort(keyOf, scratch);
+		return;
+	}
+
+	radixSort(keyOf, RadixScratch::local());
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename KeyOf>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::radixSort(KeyOf keyOf, RadixScratch& scratch)
+{
+	::radixSort(m_Data, m_Data + m_Size, keyOf, scratch);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::writeTo(std::ostream& stream) const
+{
+	static_assert(isTrivial, "Only trivially copyable elements can be written as raw bytes");
+
+	VectorFileHeader header = makeVectorFileHeader(sizeof(Type), m_Size);
+	char padding[VECTOR_FORMAT_DATA_OFFSET - sizeof(VectorFileHeader)] = {};
+
+	stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	stream.write(padding, sizeof(padding));
+	stream.write(reinterpret_cast<const char*>(m_Data), m_Size * sizeof(Type));
+
+	if (!stream)
+		throw std::runtime_error("Could not write the vector!");
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::readFrom(std::istream& stream)
+{
+	static_assert(isTrivial, "Only trivially copyable elements can be read as raw bytes");
+
+	VectorFileHeader header;
+	char padding[VECTOR_FORMAT_DATA_OFFSET - sizeof(VectorFileHeader)];
+
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+	stream.read(padding, sizeof(padding));
+
+	if (!stream)
+		throw std::runtime_error("Could not read the vector!");
+
+	checkVectorFileHeader(header, sizeof(Type));
+
+	if (header.size > AllocatorTraits::max_size(this->allocator()))
+		throw std::runtime_error("The data is too big for a vector!");
+
+	// Read on the side, so a short stream leaves this vector alone
+	Vector result(this->allocator());
+	result.reserve(static_cast<size_type>(header.size));
+
+	stream.read(reinterpret_cast<char*>(result.m_Data), static_cast<std::streamsize>(header.size * sizeof(Type)));
+
+	if (!stream)
+		throw std::runtime_error("Could not read the vector!");
+
+	result.m_Size = static_cast<size_type>(header.size);
+	*this = std::move(result);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::erase(size_type first, size_type last)
 {
 	if (first > last)
 		throw std::invalid_argument("First can not be bigger than last!");
 
-	if (first < 0)
-		throw std::out_of_range("First index is out of range!");
-
-	if (last > m_Size - 1)
+	if (last >= m_Size)
 		throw std::out_of_range("Last index is out of range!");
 
-	int diff = last - first + 1;
+	size_type diff = last - first + 1;
+
+	this->countMoves(m_Size - last - 1);
+
+	if constexpr (isTrivial)
+	{
+		std::memmove(m_Data + first, m_Data + last + 1, sizeof(Type) * (m_Size - last - 1));
+		m_Size -= diff;
+		return;
+	}
 
-	for (int i = last + 1; i <= m_Size; ++i)
+	for (size_type i = last + 1; i < m_Size; ++i)
 	{
-		m_Data[first++] = m_Data[i];
+		m_Data[first++] = std::move(m_Data[i]);
 	}
 
+	destroy(m_Data + m_Size - diff, m_Data + m_Size);
 	m_Size -= diff;
 }
 
-template<typename Type>
-inline void Vector<Type>::pushBack(const Type& el)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::remove(const Type& value)
 {
-	if (m_Size >= m_Capacity)
-		resize(m_Capacity);
+	// The value may be one of the elements, which get overwritten on the way
+	if (isInside(&value))
+	{
+		Type copy = value;
+		return removeIf([&](const Type& el) { return el == copy; });
+	}
 
-	m_Data[m_Size++] = el;
+	return removeIf([&](const Type& el) { return el == value; });
 }
 
-template<typename Type>
-inline void Vector<Type>::popBack()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename Predicate>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::removeIf(Predicate predicate)
 {
-	m_Size--;
+	size_type write = 0;
+
+	while (write < m_Size && !predicate(m_Data[write]))
+		++write;
+
+	size_type moved = 0;
+
+	for (size_type read = write + 1; read < m_Size; ++read)
+	{
+		if (!predicate(m_Data[read]))
+		{
+			m_Data[write++] = std::move(m_Data[read]);
+			++moved;
+		}
+	}
+
+	size_type removed = m_Size - write;
+
+	this->countMoves(moved);
+
+	if (removed > 0)
+	{
+		destroy(m_Data + write, m_Data + m_Size);
+		m_Size = write;
+	}
+
+	return removed;
 }
 
-template<typename Type>
-inline int Vector<Type>::calculateCapacity(const int& newSize)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::swapErase(size_type index)
 {
-	if (newSize <= 2)
-		return 4;
+	// Check if this index exists
+	at(index);
+
+	if (index != m_Size - 1)
+	{
+		m_Data[index] = std::move(m_Data[m_Size - 1]);
+		this->countMoves(1);
+	}
 
-	if (newSize <= 8)
-		return 16;
+	m_Data[--m_Size].~Type();
+}
 
-	if (newSize <= 16)
-		return 32;
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::pushBack(const Type& el)
+{
+	emplaceBack(el);
+}
 
-	return ((newSize / 16) + 1) * 16;
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::pushBack(Type&& el)
+{
+	emplaceBack(std::move(el));
 }
 
-template<typename Type>
-inline void Vector<Type>::resize(const int& newSize)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename... Args>
+inline Type& Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::emplaceBack(Args&&... args)
 {
-	int newCapacity = calculateCapacity(newSize);
-	Type* newData = new Type[newCapacity];
+	if (m_Size < m_Capacity)
+	{
+		new (m_Data + m_Size) Type(std::forward<Args>(args)...);
+		countCopiesFrom<Args...>(1);
+		return m_Data[m_Size++];
+	}
+
+	// The arguments may refer to an element of this vector,
+	// so build the new element before the old ones are moved away
+	size_type newCapacity = calculateCapacity(m_Size + 1);
+	Type* newData = allocate(newCapacity);
 
-	int i;
-	for (i = 0; i < m_Capacity && i < newCapacity; ++i)
+	try
+	{
+		new (newData + m_Size) Type(std::forward<Args>(args)...);
+	}
+	catch (...)
+	{
+		deallocate(newData, newCapacity);
+		throw;
+	}
+
+	try
+	{
+		moveElements(newData);
+	}
+	catch (...)
 	{
-		newData[i] = m_Data[i];
+		newData[m_Size].~Type();
+		deallocate(newData, newCapacity);
+		throw;
 	}
 
-	delete[] m_Data;
+	countCopiesFrom<Args...>(1);
+
+	if (m_Size > 0)
+		this->countReallocation(false);
+
+	freeMemory();
 
 	m_Data = newData;
 	m_Capacity = newCapacity;
-	m_Size = newCapacity < m_Size ? newCapacity : m_Size;
+
+	return m_Data[m_Size++];
 }
 
-template<typename Type>
-inline void Vector<Type>::freeMemory()
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::popBack()
 {
-	delete[] m_Data;
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	m_Data[--m_Size].~Type();
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline std::size_t Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::calculateCapacity(size_type newSize)
+{
+	return GrowthPolicy::nextCapacity(m_Capacity, newSize);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::reallocate(size_type newCapacity)
+{
+	// Anything that fits goes back to the inline buffer
+	bool toInline = newCapacity <= InlineCapacity;
+
+	if (toInline && isInline())
+		return;
+
+	Type* newData = toInline ? this->inlineData() : allocate(newCapacity);
+
+	try
+	{
+		moveElements(newData);
+	}
+	catch (...)
+	{
+		if (!toInline)
+			deallocate(newData, newCapacity);
+
+		throw;
+	}
+
+	if (m_Size > 0)
+		this->countReallocation(false);
+
+	freeMemory();
+
+	m_Data = newData;
+	m_Capacity = toInline ? InlineCapacity : newCapacity;
 }
 
-template<typename Type>
-inline void Vector<Type>::copy(const Vector& other)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename... Value>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::resizeTo(size_type newSize, const Value&... value)
 {
+	if (newSize <= m_Size)
+	{
+		destroy(m_Data + newSize, m_Data + m_Size);
+		m_Size = newSize;
+		return;
+	}
+
+	if (newSize <= m_Capacity)
+	{
+		fillElements(m_Data + m_Size, newSize - m_Size, value...);
+
+		countCopiesFrom<const Value&...>(newSize - m_Size);
+		m_Size = newSize;
+		return;
+	}
+
+	// Same as emplaceBack - value may live in the old buffer, so fill before moving
+	size_type newCapacity = calculateCapacity(newSize);
+	Type* newData = allocate(newCapacity);
+
+	try
+	{
+		fillElements(newData + m_Size, newSize - m_Size, value...);
+	}
+	catch (...)
+	{
+		deallocate(newData, newCapacity);
+		throw;
+	}
+
+	try
+	{
+		moveElements(newData);
+	}
+	catch (...)
+	{
+		destroy(newData + m_Size, newData + newSize);
+		deallocate(newData, newCapacity);
+		throw;
+	}
+
+	countCopiesFrom<const Value&...>(newSize - m_Size);
+
+	if (m_Size > 0)
+		this->countReallocation(true);
+
+	freeMemory();
+
+	m_Data = newData;
+	m_Capacity = newCapacity;
+	m_Size = newSize;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::freeMemory()
+{
+	destroy(m_Data, m_Data + m_Size);
+
+	if (!isInline())
+	{
+		this->countRelease(sizeof(Type) * (m_Capacity - m_Size));
+		deallocate(m_Data, m_Capacity);
+	}
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::copy(const Vector& other)
+{
+	m_Size = 0;
+
+	if (other.m_Size <= InlineCapacity)
+	{
+		m_Capacity = InlineCapacity;
+		m_Data = this->inlineData();
+	}
+	else
+	{
+		m_Capacity = other.m_Capacity;
+		m_Data = allocate(m_Capacity);
+	}
+
+	try
+	{
+		copyElements(other.m_Data, other.m_Size, m_Data);
+	}
+	catch (...)
+	{
+		freeMemory();
+		m_Capacity = InlineCapacity;
+		m_Data = this->inlineData();
+		throw;
+	}
+
 	m_Size = other.m_Size;
-	m_Capacity = other.m_Capacity;
-	m_Data = new Type[m_Capacity];
+	this->countCopies(m_Size);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::steal(Vector& other)
+{
+	// Expects this vector to be empty and back on its inline buffer
+	if (!other.isInline() && this->allocator() == other.allocator())
+	{
+		m_Data = other.m_Data;
+		m_Size = other.m_Size;
+		m_Capacity = other.m_Capacity;
+
+		other.m_Size = 0;
+		other.m_Capacity = InlineCapacity;
+		other.m_Data = other.inlineData();
+		return;
+	}
+
+	// Inline elements and memory from a different allocator can not change owners,
+	// they have to be moved one by one
+	if (other.m_Size > m_Capacity)
+	{
+		m_Data = allocate(other.m_Size);
+		m_Capacity = other.m_Size;
+	}
+
+	other.moveElements(m_Data);
+	destroy(other.m_Data, other.m_Data + other.m_Size);
+	m_Size = other.m_Size;
+	other.m_Size = 0;
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline bool Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::isInline() const
+{
+	return InlineCapacity > 0 && m_Data == this->inlineData();
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline Type* Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::allocate(size_type capacity)
+{
+	if (capacity == 0)
+		return nullptr;
+
+	this->countAllocation(sizeof(Type) * capacity);
+
+	return AllocatorTraits::allocate(this->allocator(), capacity);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::deallocate(Type* data, size_type capacity)
+{
+	if (data)
+		AllocatorTraits::deallocate(this->allocator(), data, capacity);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::destroy(Type* first, Type* last)
+{
+	if constexpr (!std::is_trivially_destructible<Type>::value)
+	{
+		for (; first != last; ++first)
+			first->~Type();
+	}
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::copyElements(const Type* source, size_type count, Type* dest)
+{
+	if (count == 0)
+		return;
+
+	if constexpr (isTrivial)
+	{
+		std::memmove(dest, source, sizeof(Type) * count);
+		return;
+	}
+
+	size_type i = 0;
+
+	try
+	{
+		for (; i < count; ++i)
+			new (dest + i) Type(source[i]);
+	}
+	catch (...)
+	{
+		destroy(dest, dest + i);
+		throw;
+	}
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename... Value>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::fillElements(Type* dest, size_type count, const Value&... value)
+{
+	// A missing value means value initialization, so ints become 0 and classes are default constructed
+	size_type i = 0;
+
+	try
+	{
+		for (; i < count; ++i)
+			new (dest + i) Type(value...);
+	}
+	catch (...)
+	{
+		destroy(dest, dest + i);
+		throw;
+	}
+}
 
-	for (int i = 0; i < other.m_Size && i < m_Capacity; i++)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::relocate(Type* source, size_type count, Type* dest)
+{
+	if constexpr (isTrivial)
 	{
-		m_Data[i] = other.m_Data[i];
+		if (count > 0)
+			std::memcpy(dest, source, sizeof(Type) * count);
+
+		return;
+	}
+
+	// Moves only if that can not throw, otherwise copies so the source stays intact
+	size_type i = 0;
+
+	try
+	{
+		for (; i < count; ++i)
+			new (dest + i) Type(std::move_if_noexcept(source[i]));
+	}
+	catch (...)
+	{
+		destroy(dest, dest + i);
+		throw;
 	}
 }
 
-template<typename Type>
-inline void Vector<Type>::swap(Vector& other)
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::moveElements(Type* dest)
 {
-	std::swap(m_Size, other.m_Size);
-	std::swap(m_Capacity, other.m_Capacity);
-	std::swap(m_Data, other.m_Data);
+	relocate(m_Data, m_Size, dest);
+	countRelocation(m_Size);
 }
 
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::countRelocation(size_type count)
+{
+	// Same choice as relocate
+	if constexpr (isTrivial || std::is_nothrow_move_constructible<Type>::value || !std::is_copy_constructible<Type>::value)
+		this->countMoves(count);
+	else
+		this->countCopies(count);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename... Args>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::countCopiesFrom(size_type count)
+{
+	// Building from a single lvalue Type is a copy, rvalues are moved in and anything else is a new value
+	if constexpr (sizeof...(Args) == 1 && (std::is_lvalue_reference<Args>::value && ...) && (std::is_same<std::decay_t<Args>, Type>::value && ...))
+		this->countCopies(count);
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+template<typename Next>
+inline void Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::insertN(size_type position, size_type count, Next next)
+{
+	// next() hands out the new elements in order, each of them exactly once
+	if (position > m_Size)
+		throw std::out_of_range("Position is out of range!");
+
+	// Shifting in place is only safe when moving can not throw, a failure half way would leave a hole.
+	// Other types take the reallocating path, which leaves the vector as it was if something throws
+	constexpr bool nothrowShift = std::is_nothrow_move_constructible<Type>::value && std::is_nothrow_move_assignable<Type>::value;
+
+	if (m_Size + count > m_Capacity || !nothrowShift)
+	{
+		// Grow once, build the new elements in place and move both halves around them
+		size_type newCapacity = calculateCapacity(m_Size + count);
+		Type* newData = allocate(newCapacity);
+		size_type constructed = 0;
+
+		try
+		{
+			for (; constructed < count; ++constructed)
+				new (newData + position + constructed) Type(next());
+
+			relocate(m_Data, position, newData);
+		}
+		catch (...)
+		{
+			destroy(newData + position, newData + position + constructed);
+			deallocate(newData, newCapacity);
+			throw;
+		}
+
+		try
+		{
+			relocate(m_Data + position, m_Size - position, newData + position + count);
+		}
+		catch (...)
+		{
+			destroy(newData, newData + position + count);
+			deallocate(newData, newCapacity);
+			throw;
+		}
+
+		countRelocation(m_Size);
+		countCopiesFrom<decltype(next())>(count);
+
+		if (m_Size > 0)
+			this->countReallocation(false);
+
+		freeMemory();
+
+		m_Data = newData;
+		m_Capacity = newCapacity;
+		m_Size += count;
+		return;
+	}
+
+	this->countMoves(m_Size - position);
+
+	if constexpr (isTrivial)
+	{
+		Type* gap = m_Data + position;
+		std::memmove(gap + count, gap, sizeof(Type) * (m_Size - position));
+
+		try
+		{
+			for (size_type i = 0; i < count; ++i)
+				new (gap + i) Type(next());
+		}
+		catch (...)
+		{
+			// Put the tail back where it was
+			std::memmove(gap, gap + count, sizeof(Type) * (m_Size - position));
+			throw;
+		}
+
+		countCopiesFrom<decltype(next())>(count);
+		m_Size += count;
+	}
+	else
+	{
+		// next() may throw and may read elements of this vector, so the new elements are built in the raw slots
+		// past the end before anything moves. The rotation after that only moves and swaps, which can not throw
+		Type* end = m_Data + m_Size;
+		size_type constructed = 0;
+
+		try
+		{
+			for (; constructed < count; ++constructed)
+				new (end + constructed) Type(next());
+		}
+		catch (...)
+		{
+			destroy(end, end + constructed);
+			throw;
+		}
+
+		std::rotate(m_Data + position, end, end + count);
+		countCopiesFrom<decltype(next())>(count);
+		m_Size += count;
+	}
+}
+
+template<typename Type, typename GrowthPolicy, typename Allocator, std::size_t InlineCapacity>
+inline bool Vector<Type, GrowthPolicy, Allocator, InlineCapacity>::isInside(const Type* ptr) const
+{
+	std::less<const Type*> less;
+
+	return !less(ptr, m_Data) && less(ptr, m_Data + m_Size);
+}
+
+// No inline buffer, a stateless allocator and stats off must cost nothing over the three members
+#ifndef VECTOR_STATS
+static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(std::size_t), "The empty bases of Vector take space!");
+#endif
+
 #endif // !VECTOR_H
\ No newline at end of file
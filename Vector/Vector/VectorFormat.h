@@ -0,0 +1,52 @@
+#ifndef VECTOR_FORMAT_H
+
+#define VECTOR_FORMAT_H
+
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+// The binary layout shared by Vector::writeTo / readFrom, VectorView and MappedVector:
+// a header, zero padding up to VECTOR_FORMAT_DATA_OFFSET and then the elements as raw bytes.
+// Everything is in the byte order of the machine that wrote it, a file from the other
+// byte order fails the magic check.
+struct VectorFileHeader
+{
+	std::uint32_t magic;
+	std::uint32_t version;
+	std::uint64_t elementSize;
+	std::uint64_t size;
+};
+
+const std::uint32_t VECTOR_FORMAT_MAGIC = 0x54434556; // "VECT"
+const std::uint32_t VECTOR_FORMAT_VERSION = 1;
+
+// Big enough for the alignment of any element a reader would map onto the data
+const std::size_t VECTOR_FORMAT_DATA_OFFSET = 64;
+
+inline VectorFileHeader makeVectorFileHeader(std::size_t elementSize, std::size_t size)
+{
+	VectorFileHeader header;
+
+	header.magic = VECTOR_FORMAT_MAGIC;
+	header.version = VECTOR_FORMAT_VERSION;
+	header.elementSize = elementSize;
+	header.size = size;
+
+	return header;
+}
+
+// Throws std::runtime_error unless the header describes elements of elementSize bytes
+inline void checkVectorFileHeader(const VectorFileHeader& header, std::size_t elementSize)
+{
+	if (header.magic != VECTOR_FORMAT_MAGIC)
+		throw std::runtime_error("The data is not a serialized vector!");
+
+	if (header.version == 0 || header.version > VECTOR_FORMAT_VERSION)
+		throw std::runtime_error("The data has an unknown format version!");
+
+	if (header.elementSize != elementSize)
+		throw std::runtime_error("The data holds elements of a different size!");
+}
+
+#endif // !VECTOR_FORMAT_H
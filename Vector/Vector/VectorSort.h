@@ -0,0 +1,307 @@
+#ifndef VECTOR_SORT_H
+
+#define VECTOR_SORT_H
+
+#include "ThreadPool.h"
+
+#include <type_traits>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+// Sorting over plain arrays, used by Vector::sort.
+// introSort is the single threaded one, parallelSort splits big inputs into chunks that are
+// introsorted on a ThreadPool and then merged pairwise, every merge split across the threads too.
+
+template <typename Type, typename Compare>
+void insertionSort(Type* first, Type* last, Compare& comp)
+{
+	if (first == last)
+		return;
+
+	for (Type* current = first + 1; current != last; ++current)
+	{
+		Type value = std::move(*current);
+		Type* hole = current;
+
+		for (; hole != first && comp(value, *(hole - 1)); --hole)
+			*hole = std::move(*(hole - 1));
+
+		*hole = std::move(value);
+	}
+}
+
+template <typename Type, typename Compare>
+void siftDown(Type* heap, std::size_t root, std::size_t size, Compare& comp)
+{
+	Type value = std::move(heap[root]);
+
+	for (std::size_t child = 2 * root + 1; child < size; child = 2 * root + 1)
+	{
+		if (child + 1 < size && comp(heap[child], heap[child + 1]))
+			++child;
+
+		if (!comp(value, heap[child]))
+			break;
+
+		heap[root] = std::move(heap[child]);
+		root = child;
+	}
+
+	heap[root] = std::move(value);
+}
+
+template <typename Type, typename Compare>
+void heapSort(Type* first, Type* last, Compare& comp)
+{
+	std::size_t size = last - first;
+
+	for (std::size_t i = size / 2; i-- > 0; )
+		siftDown(first, i, size, comp);
+
+	for (std::size_t end = size; end-- > 1; )
+	{
+		std::swap(first[0], first[end]);
+		siftDown(first, 0, end, comp);
+	}
+}
+
+template <typename Type, typename Compare>
+Type* partitionAroundMedian(Type* first, Type* last, Compare& comp)
+{
+	// Puts the median of three in front as the pivot. There is something on both sides
+	// that stops the scans, so they need no bounds checks
+	Type* a = first + 1;
+	Type* b = first + (last - first) / 2;
+	Type* c = last - 1;
+
+	if (comp(*a, *b))
+	{
+		if (comp(*b, *c))
+			std::swap(*first, *b);
+		else if (comp(*a, *c))
+			std::swap(*first, *c);
+		else
+			std::swap(*first, *a);
+	}
+	else if (comp(*a, *c))
+		std::swap(*first, *a);
+	else if (comp(*b, *c))
+		std::swap(*first, *c);
+	else
+		std::swap(*first, *b);
+
+	Type* left = first + 1;
+	Type* right = last;
+
+	for (;;)
+	{
+		while (comp(*left, *first))
+			++left;
+
+		--right;
+
+		while (comp(*first, *right))
+			--right;
+
+		if (!(left < right))
+			return left;
+
+		std::swap(*left, *right);
+		++left;
+	}
+}
+
+template <typename Type, typename Compare>
+void introSortLoop(Type* first, Type* last, std::size_t depthLimit, Compare& comp)
+{
+	// Small ranges are left for the final insertion sort
+	while (last - first > 16)
+	{
+		if (depthLimit == 0)
+		{
+			heapSort(first, last, comp);
+			return;
+		}
+
+		--depthLimit;
+
+		Type* cut = partitionAroundMedian(first, last, comp);
+		introSortLoop(cut, last, depthLimit, comp);
+		last = cut;
+	}
+}
+
+template <typename Type, typename Compare>
+void introSort(Type* first, Type* last, Compare comp)
+{
+	std::size_t depthLimit = 0;
+
+	for (std::size_t size = last - first; size > 1; size >>= 1)
+		depthLimit += 2;
+
+	introSortLoop(first, last, depthLimit, comp);
+	insertionSort(first, last, comp);
+}
+
+template <typename Type, typename Compare>
+void mergeRuns(Type* left, Type* leftEnd, Type* right, Type* rightEnd, Type* dest, Compare& comp)
+{
+	while (left != leftEnd && right != rightEnd)
+	{
+		if (comp(*right, *left))
+			*dest++ = std::move(*right++);
+		else
+			*dest++ = std::move(*left++);
+	}
+
+	while (left != leftEnd)
+		*dest++ = std::move(*left++);
+
+	while (right != rightEnd)
+		*dest++ = std::move(*right++);
+}
+
+template <typename Type, typename Compare>
+Type* lowerBound(Type* first, Type* last, const Type& value, Compare& comp)
+{
+	std::size_t size = last - first;
+
+	while (size > 0)
+	{
+		std::size_t half = size / 2;
+
+		if (comp(first[half], value))
+		{
+			first += half + 1;
+			size -= half + 1;
+		}
+		else
+			size = half;
+	}
+
+	return first;
+}
+
+// Below this many elements per thread the threads cost more than they save
+const std::size_t PARALLEL_SORT_MIN_CHUNK = 1 << 15;
+
+template <typename Type, typename Compare>
+void parallelMergeSort(Type* first, Type* last, Compare& comp, ThreadPool& pool, std::size_t chunks)
+{
+	std::size_t size = last - first;
+	std::unique_ptr<Type[]> scratch(new Type[size]);
+
+	// Run i is [bounds[i], bounds[i + 1])
+	std::unique_ptr<std::size_t[]> bounds(new std::size_t[chunks + 1]);
+
+	for (std::size_t i = 0; i <= chunks; ++i)
+		bounds[i] = size * i / chunks;
+
+	pool.parallelFor(chunks, [&](std::size_t i)
+	{
+		introSort(first + bounds[i], first + bounds[i + 1], comp);
+	});
+
+	Type* source = first;
+	Type* dest = scratch.get();
+	std::size_t runs = chunks;
+
+	// Where every piece of a merge starts in its right run
+	std::unique_ptr<Type*[]> splits(new Type*[chunks + 1]);
+
+	while (runs > 1)
+	{
+		// Every pair of runs is merged in pieces, so all threads stay busy even in the last round
+		std::size_t pairs = runs / 2;
+		std::size_t piecesPerPair = chunks / pairs;
+		std::size_t pieces = pairs * piecesPerPair;
+
+		// Split the left runs evenly and find where each split lands in the right run.
+		// This is done before any merging, the merges move the split elements away
+		pool.parallelFor(pieces, [&](std::size_t task)
+		{
+			std::size_t pair = task / piecesPerPair;
+			std::size_t piece = task % piecesPerPair;
+
+			Type* left = source + bounds[2 * pair];
+			Type* middle = source + bounds[2 * pair + 1];
+			Type* right = source + bounds[2 * pair + 2];
+
+			splits[task] = piece == 0 ? middle : lowerBound(middle, right, left[(middle - left) * piece / piecesPerPair], comp);
+		});
+
+		pool.parallelFor(pieces + runs % 2, [&](std::size_t task)
+		{
+			if (task == pieces)
+			{
+				// The odd run out is just moved over
+				for (std::size_t i = bounds[runs - 1]; i < bounds[runs]; ++i)
+					dest[i] = std::move(source[i]);
+
+				return;
+			}
+
+			std::size_t pair = task / piecesPerPair;
+			std::size_t piece = task % piecesPerPair;
+
+			Type* left = source + bounds[2 * pair];
+			Type* middle = source + bounds[2 * pair + 1];
+			Type* right = source + bounds[2 * pair + 2];
+
+			std::size_t leftSize = middle - left;
+			Type* leftFrom = left + leftSize * piece / piecesPerPair;
+			Type* leftTo = left + leftSize * (piece + 1) / piecesPerPair;
+			Type* rightFrom = splits[task];
+			Type* rightTo = piece + 1 == piecesPerPair ? right : splits[task + 1];
+
+			Type* out = dest + (leftFrom - source) + (rightFrom - middle);
+			mergeRuns(leftFrom, leftTo, rightFrom, rightTo, out, comp);
+		});
+
+		for (std::size_t i = 0; i < pairs; ++i)
+			bounds[i + 1] = bounds[2 * i + 2];
+
+		if (runs % 2)
+			bounds[pairs + 1] = bounds[runs];
+
+		runs = pairs + runs % 2;
+		std::swap(source, dest);
+	}
+
+	if (source != first)
+	{
+		pool.parallelFor(chunks, [&](std::size_t i)
+		{
+			std::size_t from = size * i / chunks;
+			std::size_t to = size * (i + 1) / chunks;
+
+			for (std::size_t j = from; j < to; ++j)
+				first[j] = std::move(source[j]);
+		});
+	}
+}
+
+template <typename Type, typename Compare>
+void parallelSort(Type* first, Type* last, Compare comp, ThreadPool& pool = ThreadPool::shared())
+{
+	std::size_t size = last - first;
+	std::size_t chunks = pool.size();
+
+	if (size / PARALLEL_SORT_MIN_CHUNK < chunks)
+		chunks = size / PARALLEL_SORT_MIN_CHUNK;
+
+	// The merges need a scratch buffer, so the elements have to be default constructible
+	if constexpr (std::is_default_constructible<Type>::value)
+	{
+		if (chunks > 1)
+		{
+			parallelMergeSort(first, last, comp, pool, chunks);
+			return;
+		}
+	}
+
+	introSort(first, last, comp);
+}
+
+#endif // !VECTOR_SORT_H
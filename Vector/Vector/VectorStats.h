@@ -0,0 +1,195 @@
+#ifndef VECTOR_STATS_H
+
+#define VECTOR_STATS_H
+
+#include <cstddef>
+#include <atomic>
+#include <ostream>
+
+// Allocation and copy counters for Vector. Off by default - define VECTOR_STATS for the whole program
+// (-DVECTOR_STATS) to turn them on. When off every hook is an empty inline function that compiles away
+// and the holder is an empty base that takes no space.
+//
+// Each vector counts its own events (Vector::stats()) and adds them to a process wide total
+// (globalVectorStats(), dumpVectorStats()). The totals are relaxed atomics, fine to read from any thread.
+
+#ifdef VECTOR_STATS
+const bool VECTOR_STATS_ENABLED = true;
+#else
+const bool VECTOR_STATS_ENABLED = false;
+#endif
+
+struct VectorStats
+{
+	// Heap buffers taken from the allocator
+	std::size_t allocations;
+	// Times the elements were moved to a new buffer because it ran out of room (or was shrunk)
+	std::size_t reallocations;
+	// The part of reallocations that came from resize
+	std::size_t resizeReallocations;
+	// Elements copy constructed from other elements, and elements moved or memcpy'd to another slot
+	std::size_t elementCopies;
+	std::size_t elementMoves;
+	std::size_t bytesAllocated;
+	// The biggest single buffer
+	std::size_t peakCapacityBytes;
+	// Unused capacity of heap buffers at the moment they were freed
+	std::size_t wastedSlackBytes;
+};
+
+struct VectorStatsTotals
+{
+	std::atomic<std::size_t> allocations{ 0 };
+	std::atomic<std::size_t> reallocations{ 0 };
+	std::atomic<std::size_t> resizeReallocations{ 0 };
+	std::atomic<std::size_t> elementCopies{ 0 };
+	std::atomic<std::size_t> elementMoves{ 0 };
+	std::atomic<std::size_t> bytesAllocated{ 0 };
+	std::atomic<std::size_t> peakCapacityBytes{ 0 };
+	std::atomic<std::size_t> wastedSlackBytes{ 0 };
+
+	static VectorStatsTotals& instance()
+	{
+		static VectorStatsTotals totals;
+		return totals;
+	}
+};
+
+// Everything every Vector has counted since the start (or the last reset). All zeros when VECTOR_STATS is off
+inline VectorStats globalVectorStats()
+{
+	VectorStatsTotals& totals = VectorStatsTotals::instance();
+	VectorStats stats;
+
+	stats.allocations = totals.allocations.load(std::memory_order_relaxed);
+	stats.reallocations = totals.reallocations.load(std::memory_order_relaxed);
+	stats.resizeReallocations = totals.resizeReallocations.load(std::memory_order_relaxed);
+	stats.elementCopies = totals.elementCopies.load(std::memory_order_relaxed);
+	stats.elementMoves = totals.elementMoves.load(std::memory_order_relaxed);
+	stats.bytesAllocated = totals.bytesAllocated.load(std::memory_order_relaxed);
+	stats.peakCapacityBytes = totals.peakCapacityBytes.load(std::memory_order_relaxed);
+	stats.wastedSlackBytes = totals.wastedSlackBytes.load(std::memory_order_relaxed);
+
+	return stats;
+}
+
+inline void resetVectorStats()
+{
+	VectorStatsTotals& totals = VectorStatsTotals::instance();
+
+	totals.allocations.store(0, std::memory_order_relaxed);
+	totals.reallocations.store(0, std::memory_order_relaxed);
+	totals.resizeReallocations.store(0, std::memory_order_relaxed);
+	totals.elementCopies.store(0, std::memory_order_relaxed);
+	totals.elementMoves.store(0, std::memory_order_relaxed);
+	totals.bytesAllocated.store(0, std::memory_order_relaxed);
+	totals.peakCapacityBytes.store(0, std::memory_order_relaxed);
+	totals.wastedSlackBytes.store(0, std::memory_order_relaxed);
+}
+
+inline void dumpVectorStats(std::ostream& stream)
+{
+	if (!VECTOR_STATS_ENABLED)
+	{
+		stream << "Vector stats are off, build with VECTOR_STATS defined\n";
+		return;
+	}
+
+	VectorStats stats = globalVectorStats();
+
+	stream << "Vector stats\n"
+		<< "  allocations:          " << stats.allocations << '\n'
+		<< "  reallocations:        " << stats.reallocations << " (" << stats.resizeReallocations << " from resize)\n"
+		<< "  element copies:       " << stats.elementCopies << '\n'
+		<< "  element moves:        " << stats.elementMoves << '\n'
+		<< "  bytes allocated:      " << stats.bytesAllocated << '\n'
+		<< "  peak capacity bytes:  " << stats.peakCapacityBytes << '\n'
+		<< "  wasted slack bytes:   " << stats.wastedSlackBytes << '\n';
+}
+
+// Vector inherits from this, the same way it does from AllocatorHolder
+#ifdef VECTOR_STATS
+
+struct VectorStatsHolder
+{
+	VectorStats stats() const { return m_Stats; }
+
+protected:
+	void countAllocation(std::size_t bytes)
+	{
+		VectorStatsTotals& totals = VectorStatsTotals::instance();
+
+		++m_Stats.allocations;
+		m_Stats.bytesAllocated += bytes;
+
+		if (bytes > m_Stats.peakCapacityBytes)
+			m_Stats.peakCapacityBytes = bytes;
+
+		totals.allocations.fetch_add(1, std::memory_order_relaxed);
+		totals.bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+
+		std::size_t peak = totals.peakCapacityBytes.load(std::memory_order_relaxed);
+
+		while (bytes > peak && !totals.peakCapacityBytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed))
+			;
+	}
+
+	void countReallocation(bool fromResize)
+	{
+		VectorStatsTotals& totals = VectorStatsTotals::instance();
+
+		++m_Stats.reallocations;
+		totals.reallocations.fetch_add(1, std::memory_order_relaxed);
+
+		if (fromResize)
+		{
+			++m_Stats.resizeReallocations;
+			totals.resizeReallocations.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+
+	void countCopies(std::size_t count)
+	{
+		if (count == 0)
+			return;
+
+		m_Stats.elementCopies += count;
+		VectorStatsTotals::instance().elementCopies.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	void countMoves(std::size_t count)
+	{
+		if (count == 0)
+			return;
+
+		m_Stats.elementMoves += count;
+		VectorStatsTotals::instance().elementMoves.fetch_add(count, std::memory_order_relaxed);
+	}
+
+	void countRelease(std::size_t slackBytes)
+	{
+		m_Stats.wastedSlackBytes += slackBytes;
+		VectorStatsTotals::instance().wastedSlackBytes.fetch_add(slackBytes, std::memory_order_relaxed);
+	}
+
+private:
+	VectorStats m_Stats{};
+};
+
+#else
+
+struct VectorStatsHolder
+{
+	VectorStats stats() const { return VectorStats{}; }
+
+protected:
+	void countAllocation(std::size_t) {}
+	void countReallocation(bool) {}
+	void countCopies(std::size_t) {}
+	void countMoves(std::size_t) {}
+	void countRelease(std::size_t) {}
+};
+
+#endif
+
+#endif // !VECTOR_STATS_H
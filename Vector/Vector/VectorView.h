@@ -0,0 +1,126 @@
+#ifndef VECTOR_VIEW_H
+
+#define VECTOR_VIEW_H
+
+#include "VectorFormat.h"
+
+#include <type_traits>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Read only access to a vector in the VectorFormat.h layout, without copying it out:
+// a buffer filled by Vector::writeTo, a file that was read or mapped, or a MappedVector's file.
+// The buffer has to outlive the view.
+template <typename Type>
+class VectorView
+{
+	static_assert(std::is_trivially_copyable<Type>::value, "Only trivially copyable elements can be viewed in place");
+	static_assert(alignof(Type) <= VECTOR_FORMAT_DATA_OFFSET, "The elements would not be aligned in the buffer");
+
+public:
+	using value_type = Type;
+	using size_type = std::size_t;
+	using const_reference = const Type&;
+	using const_pointer = const Type*;
+
+	VectorView();
+	// Throws std::runtime_error when the buffer does not hold a vector of Type,
+	// is too short for the size in its header or is not aligned for Type
+	VectorView(const void* buffer, size_type bufferSize);
+
+	const Type& operator[] (size_type index) const;
+	const Type& at(size_type index) const;
+	const Type& back() const;
+	const Type& front() const;
+
+	const Type* data() const;
+	size_type size() const;
+	bool empty() const;
+
+private:
+	const Type* m_Data;
+	size_type m_Size;
+};
+
+template<typename Type>
+inline VectorView<Type>::VectorView()
+	: m_Data(nullptr), m_Size(0)
+{
+}
+
+template<typename Type>
+inline VectorView<Type>::VectorView(const void* buffer, size_type bufferSize)
+{
+	if (bufferSize < VECTOR_FORMAT_DATA_OFFSET)
+		throw std::runtime_error("The buffer is too short for a serialized vector!");
+
+	if (reinterpret_cast<std::uintptr_t>(buffer) % alignof(Type) != 0)
+		throw std::runtime_error("The buffer is not aligned for the elements!");
+
+	// The header is copied out since the buffer may not be aligned for it
+	VectorFileHeader header;
+	std::memcpy(&header, buffer, sizeof(header));
+
+	checkVectorFileHeader(header, sizeof(Type));
+
+	if (header.size > (bufferSize - VECTOR_FORMAT_DATA_OFFSET) / sizeof(Type))
+		throw std::runtime_error("The buffer is shorter than its size says!");
+
+	m_Data = reinterpret_cast<const Type*>(static_cast<const unsigned char*>(buffer) + VECTOR_FORMAT_DATA_OFFSET);
+	m_Size = static_cast<size_type>(header.size);
+}
+
+template<typename Type>
+inline const Type& VectorView<Type>::operator[] (size_type index) const
+{
+	return m_Data[index];
+}
+
+template<typename Type>
+inline const Type& VectorView<Type>::at(size_type index) const
+{
+	if (index >= m_Size)
+		throw std::out_of_range("Index is out of range!");
+
+	return m_Data[index];
+}
+
+template<typename Type>
+inline const Type& VectorView<Type>::back() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[m_Size - 1];
+}
+
+template<typename Type>
+inline const Type& VectorView<Type>::front() const
+{
+	if (empty())
+		throw std::logic_error("The vector is empty!");
+
+	return m_Data[0];
+}
+
+template<typename Type>
+inline const Type* VectorView<Type>::data() const
+{
+	return m_Data;
+}
+
+template<typename Type>
+inline std::size_t VectorView<Type>::size() const
+{
+	return m_Size;
+}
+
+template<typename Type>
+inline bool VectorView<Type>::empty() const
+{
+	return m_Size == 0;
+}
+
+#endif // !VECTOR_VIEW_H
@@ -0,0 +1,278 @@
+#include "Vector.h"
+#include "String.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <optional>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+// Vector against std::vector, operation by operation. Built by the CMake project in the Vector folder,
+// run as VectorVsStd [max elements] [max bytes per container] (10^8 and 1 GiB by default).
+// Sizes whose containers would go over the byte limit are skipped.
+//
+// ns/op is per element for the whole container operations (pushBack, copy, read, iterate)
+// and per call for insert, erase and move. allocs is the heap allocations of one run on one container,
+// elements included - a String allocates its characters too.
+
+// Every heap allocation in the program goes through here
+static std::size_t allocationCount = 0;
+
+void* operator new(std::size_t size)
+{
+	++allocationCount;
+
+	if (void* data = std::malloc(size ? size : 1))
+		return data;
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* data) noexcept
+{
+	std::free(data);
+}
+
+void operator delete(void* data, std::size_t) noexcept
+{
+	std::free(data);
+}
+
+struct LargePod
+{
+	double values[32];
+};
+
+// Rough heap use of an element besides sizeof, for the byte limit
+template <typename Type>
+std::size_t heapBytes() { return 0; }
+
+template <>
+std::size_t heapBytes<String>() { return 32; }
+
+template <typename Type>
+Type makeValue(std::size_t i);
+
+template <>
+int makeValue<int>(std::size_t i)
+{
+	return static_cast<int>(i);
+}
+
+template <>
+String makeValue<String>(std::size_t i)
+{
+	return String(("element " + std::to_string(i)).c_str());
+}
+
+template <>
+LargePod makeValue<LargePod>(std::size_t i)
+{
+	LargePod pod;
+
+	for (int j = 0; j < 32; ++j)
+		pod.values[j] = static_cast<double>(i + j);
+
+	return pod;
+}
+
+// Something cheap to read from an element, so reads can not be optimized away
+inline std::size_t touch(int value) { return static_cast<std::size_t>(value); }
+inline std::size_t touch(const String& value) { return static_cast<std::size_t>(value.size()); }
+inline std::size_t touch(const LargePod& value) { return static_cast<std::size_t>(value.values[0]); }
+
+// The same operations on both containers
+template <typename Type>
+void append(std::vector<Type>& vector, const Type& value) { vector.push_back(value); }
+
+template <typename Type>
+void append(Vector<Type>& vector, const Type& value) { vector.pushBack(value); }
+
+template <typename Type>
+void insertMiddle(std::vector<Type>& vector, const Type& value) { vector.insert(vector.begin() + vector.size() / 2, value); }
+
+template <typename Type>
+void insertMiddle(Vector<Type>& vector, const Type& value) { vector.insert(vector.size() / 2, 1, value); }
+
+template <typename Type>
+void eraseMiddle(std::vector<Type>& vector) { vector.erase(vector.begin() + vector.size() / 2); }
+
+template <typename Type>
+void eraseMiddle(Vector<Type>& vector) { vector.erase(vector.size() / 2); }
+
+struct Result
+{
+	double nsPerOp;
+	double allocations;
+};
+
+static volatile std::size_t sink = 0;
+
+// Runs op once on each of rounds containers prepared by setup and keeps the best of a few tries.
+// Setting up and destroying the containers is not timed. op gets an empty slot for a container it makes
+template <typename Container, typename Setup, typename Op>
+Result measure(std::size_t rounds, std::size_t opsPerRound, Setup setup, Op op)
+{
+	Result best{ 0, 0 };
+
+	for (int attempt = 0; attempt < 3; ++attempt)
+	{
+		std::vector<Container> containers(rounds);
+		std::vector<std::optional<Container>> made(rounds);
+
+		for (Container& container : containers)
+			setup(container);
+
+		std::size_t allocationsBefore = allocationCount;
+		auto start = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0; i < rounds; ++i)
+			op(containers[i], made[i]);
+
+		auto end = std::chrono::steady_clock::now();
+		std::size_t allocations = allocationCount - allocationsBefore;
+
+		double ns = std::chrono::duration<double, std::nano>(end - start).count() / (rounds * opsPerRound);
+
+		if (attempt == 0 || ns < best.nsPerOp)
+			best = Result{ ns, static_cast<double>(allocations) / rounds };
+	}
+
+	return best;
+}
+
+template <typename Container, typename Type>
+void fillWith(Container& container, const std::vector<Type>& values, std::size_t size)
+{
+	for (std::size_t i = 0; i < size; ++i)
+		append(container, values[i % values.size()]);
+}
+
+// ns/op and allocations of every operation, in print order
+template <typename Container, typename Type>
+std::vector<Result> runAll(std::size_t size, std::size_t rounds, const std::vector<Type>& values)
+{
+	using Made = std::optional<Container>;
+
+	std::vector<Result> results;
+	auto filled = [&](Container& container) { fillWith(container, values, size); };
+	auto nothing = [](Container&) {};
+
+	// Small sizes would finish faster than the clock ticks, so they get many containers per run
+	results.push_back(measure<Container>(rounds, size, nothing, [&](Container& container, Made&)
+	{
+		fillWith(container, values, size);
+	}));
+
+	// Each insert and erase shifts half the elements, so big sizes get fewer of them
+	std::size_t changes = std::min({ size / 2, std::size_t(1000), std::size_t(1000000000) / size });
+
+	if (changes == 0)
+		changes = 1;
+
+	results.push_back(measure<Container>(rounds, changes, filled, [&](Container& container, Made&)
+	{
+		for (std::size_t i = 0; i < changes; ++i)
+			insertMiddle(container, values[i % values.size()]);
+	}));
+
+	results.push_back(measure<Container>(rounds, changes, filled, [&](Container& container, Made&)
+	{
+		for (std::size_t i = 0; i < changes; ++i)
+			eraseMiddle(container);
+	}));
+
+	results.push_back(measure<Container>(rounds, size, filled, [&](Container& container, Made& made)
+	{
+		made.emplace(container);
+	}));
+
+	results.push_back(measure<Container>(rounds, 1, filled, [&](Container& container, Made& made)
+	{
+		made.emplace(std::move(container));
+	}));
+
+	results.push_back(measure<Container>(rounds, size, filled, [&](Container& container, Made&)
+	{
+		std::size_t total = 0;
+
+		for (std::size_t i = 0; i < container.size(); ++i)
+			total += touch(container[i]);
+
+		sink = sink + total;
+	}));
+
+	results.push_back(measure<Container>(rounds, size, filled, [&](Container& container, Made&)
+	{
+		std::size_t total = 0;
+
+		for (const Type& value : container)
+			total += touch(value);
+
+		sink = sink + total;
+	}));
+
+	return results;
+}
+
+template <typename Type>
+void compareType(const char* name, std::size_t maxSize, std::size_t maxBytes)
+{
+	static const char* operations[] = { "pushBack", "insert", "erase", "copy", "move", "read", "iterate" };
+
+	std::cout << "\nVector<" << name << "> vs std::vector<" << name << ">\n";
+	std::cout << std::left << std::setw(12) << "size" << std::setw(10) << "operation"
+		<< std::right << std::setw(14) << "Vector ns/op" << std::setw(12) << "std ns/op" << std::setw(9) << "ratio"
+		<< std::setw(15) << "Vector allocs" << std::setw(12) << "std allocs\n";
+
+	std::vector<Type> values;
+
+	for (std::size_t i = 0; i < 1024; ++i)
+		values.push_back(makeValue<Type>(i));
+
+	for (std::size_t size = 10; size <= maxSize; size *= 10)
+	{
+		if (size * (sizeof(Type) + heapBytes<Type>()) > maxBytes)
+		{
+			std::cout << std::left << std::setw(12) << size << "skipped, over the byte limit\n";
+			continue;
+		}
+
+		// About a million elements per run
+		std::size_t rounds = size < 1000000 ? 1000000 / size : 1;
+
+		std::vector<Result> ours = runAll<Vector<Type>>(size, rounds, values);
+		std::vector<Result> theirs = runAll<std::vector<Type>>(size, rounds, values);
+
+		for (std::size_t i = 0; i < ours.size(); ++i)
+		{
+			std::cout << std::left << std::setw(12) << size << std::setw(10) << operations[i]
+				<< std::right << std::fixed << std::setprecision(2)
+				<< std::setw(14) << ours[i].nsPerOp
+				<< std::setw(12) << theirs[i].nsPerOp
+				<< std::setw(8) << theirs[i].nsPerOp / ours[i].nsPerOp << "x"
+				<< std::setprecision(1)
+				<< std::setw(15) << ours[i].allocations
+				<< std::setw(11) << theirs[i].allocations << '\n';
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::size_t maxSize = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+	std::size_t maxBytes = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::size_t(1) << 30;
+
+	std::cout << "ratio is std ns/op over Vector ns/op, above 1x means Vector is faster\n";
+
+	compareType<int>("int", maxSize, maxBytes);
+	compareType<String>("String", maxSize, maxBytes);
+	compareType<LargePod>("LargePod", maxSize, maxBytes);
+
+	return 0;
+}
@@ -0,0 +1,2305 @@
+#define DOCTEST_CONFIG_IMPLEMENT
+#include "doctest.h"
+#include <vector>
+#include <list>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <thread>
+#include <memory>
+#include <type_traits>
+#include <limits>
+#include <cstddef>
+
+#include "../Vector.h"
+#include "../SmallVector.h"
+#include "../ArenaAllocator.h"
+#include "../MappedVector.h"
+#include "../VectorView.h"
+#include "../SoAVector.h"
+#include "../ConcurrentVector.h"
+#include "../SegmentedVector.h"
+#include "../AlignedAllocator.h"
+#include "../SharedVector.h"
+#include "../BitVector.h"
+#include "../RingBuffer.h"
+#include "../CompressedIntVector.h"
+
+// The elements of any of the containers, for comparing against std::vector
+template <typename Container>
+auto toStd(const Container& container)
+{
+	std::vector<std::decay_t<decltype(container[0])>> values;
+
+	for (decltype(container.size()) i = 0; i < container.size(); ++i)
+		values.push_back(container[i]);
+
+	return values;
+}
+
+// Counts the live objects and has no default constructor, so spare capacity can not hold any
+struct Counted
+{
+	static int live;
+
+	int value;
+
+	explicit Counted(int value) : value(value) { ++live; }
+	Counted(const Counted& other) : value(other.value) { ++live; }
+	Counted(Counted&& other) noexcept : value(other.value) { ++live; }
+
+	Counted& operator= (const Counted& other) = default;
+	Counted& operator= (Counted&& other) noexcept = default;
+
+	~Counted() { --live; }
+};
+
+int Counted::live = 0;
+
+struct Pod
+{
+	int id;
+	double weight;
+
+	bool operator== (const Pod& other) const { return id == other.id && weight == other.weight; }
+};
+
+// The same as Pod, but not trivially copyable
+struct NonTrivialPod : Pod
+{
+	NonTrivialPod(int id) : Pod{ id, id * 0.5 } {}
+	NonTrivialPod(const NonTrivialPod& other) : Pod(other) {}
+	NonTrivialPod& operator= (const NonTrivialPod& other) { Pod::operator=(other); return *this; }
+};
+
+// std::allocator that counts what goes through it
+template <typename Type>
+struct CountingAllocator
+{
+	using value_type = Type;
+
+	int* allocations;
+	int* deallocations;
+
+	CountingAllocator(int* allocations, int* deallocations) : allocations(allocations), deallocations(deallocations) {}
+
+	template <typename Other>
+	CountingAllocator(const CountingAllocator<Other>& other) : allocations(other.allocations), deallocations(other.deallocations) {}
+
+	Type* allocate(std::size_t count)
+	{
+		++*allocations;
+		return std::allocator<Type>().allocate(count);
+	}
+
+	void deallocate(Type* data, std::size_t count)
+	{
+		++*deallocations;
+		std::allocator<Type>().deallocate(data, count);
+	}
+
+	bool operator== (const CountingAllocator& other) const { return allocations == other.allocations; }
+	bool operator!= (const CountingAllocator& other) const { return allocations != other.allocations; }
+};
+
+// Whether the elements are stored inside the object itself
+template <typename Container>
+bool storedInside(const Container& container)
+{
+	const char* data = reinterpret_cast<const char*>(container.data());
+	const char* object = reinterpret_cast<const char*>(&container);
+
+	return data >= object && data < object + sizeof(container);
+}
+
+// The capacities a vector goes through while n elements are pushed
+template <typename VectorType>
+std::vector<int> capacitiesWhilePushing(int n)
+{
+	VectorType vec;
+	std::vector<int> capacities;
+
+	for (int i = 0; i < n; ++i)
+	{
+		vec.pushBack(i);
+
+		if (capacities.empty() || capacities.back() != static_cast<int>(vec.capacity()))
+			capacities.push_back(static_cast<int>(vec.capacity()));
+	}
+
+	return capacities;
+}
+
+TEST_CASE("Growth policies")
+{
+	SUBCASE("Geometric")
+	{
+		CHECK(GeometricGrowth<>::nextCapacity(0, 1) == 4);
+		CHECK(GeometricGrowth<>::nextCapacity(4, 5) == 6);
+		CHECK(GeometricGrowth<>::nextCapacity(100, 101) == 150);
+		CHECK(GeometricGrowth<>::nextCapacity(100, 500) == 500);
+		CHECK(DoublingGrowth::nextCapacity(8, 9) == 16);
+	}
+
+	SUBCASE("Fixed step and power of two")
+	{
+		CHECK(FixedStepGrowth<16>::nextCapacity(0, 1) == 16);
+		CHECK(FixedStepGrowth<16>::nextCapacity(16, 17) == 32);
+		CHECK(PowerOfTwoGrowth::nextCapacity(0, 33) == 64);
+		CHECK(PowerOfTwoGrowth::nextCapacity(64, 65) == 128);
+	}
+
+	SUBCASE("Appends reallocate a logarithmic number of times")
+	{
+		std::vector<int> geometric = capacitiesWhilePushing<Vector<int>>(100000);
+		std::vector<int> doubling = capacitiesWhilePushing<Vector<int, DoublingGrowth>>(100000);
+		std::vector<int> steps = capacitiesWhilePushing<Vector<int, FixedStepGrowth<1000>>>(100000);
+
+		CHECK(geometric.size() < 30);
+		CHECK(doubling.size() < 20);
+		CHECK(steps.size() == 100);
+
+		for (std::size_t i = 1; i < doubling.size(); ++i)
+			CHECK(doubling[i] == 2 * doubling[i - 1]);
+	}
+
+	SUBCASE("Elements survive growing")
+	{
+		Vector<int, PowerOfTwoGrowth> vec;
+		std::vector<int> expected;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			vec.pushBack(i * 3);
+			expected.push_back(i * 3);
+		}
+
+		int more[] = { -1, -2, -3 };
+		vec.insert(more, 3);
+		expected.insert(expected.end(), more, more + 3);
+
+		CHECK(toStd(vec) == expected);
+		CHECK(vec.capacity() == 1024);
+	}
+}
+
+TEST_CASE("Raw storage and in-place construction")
+{
+	SUBCASE("Only the elements are constructed")
+	{
+		{
+			Vector<Counted> vec;
+
+			for (int i = 0; i < 100; ++i)
+				vec.emplaceBack(i);
+
+			CHECK(vec.capacity() > vec.size());
+			CHECK(Counted::live == 100);
+
+			vec.popBack();
+			vec.erase(10);
+			vec.erase(20, 29);
+			CHECK(vec.size() == 88);
+			CHECK(Counted::live == 88);
+			CHECK(vec[10].value == 11);
+			CHECK(vec[20].value == 31);
+
+			Vector<Counted> copy(vec);
+			CHECK(Counted::live == 176);
+
+			copy.clear();
+			CHECK(Counted::live == 88);
+		}
+		CHECK(Counted::live == 0);
+	}
+
+	SUBCASE("Move only elements")
+	{
+		Vector<std::unique_ptr<int>> vec;
+
+		for (int i = 0; i < 50; ++i)
+			vec.pushBack(std::make_unique<int>(i));
+
+		vec.erase(0);
+
+		CHECK(vec.size() == 49);
+		CHECK(*vec[0] == 1);
+		CHECK(*vec[48] == 49);
+	}
+
+	SUBCASE("emplaceBack forwards the arguments")
+	{
+		Vector<std::string> vec;
+
+		vec.emplaceBack(3, 'x');
+		vec.emplaceBack("abc");
+		std::string moved = "moved";
+		vec.pushBack(std::move(moved));
+
+		CHECK(vec[0] == "xxx");
+		CHECK(vec[1] == "abc");
+		CHECK(vec[2] == "moved");
+	}
+}
+
+// Copies, grows, inserts and erases, and checks the elements against std::vector after each step
+template <typename Type, typename Make>
+void checkBulkOperations(Make make)
+{
+	Vector<Type> vec;
+	std::vector<Type> expected;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		vec.pushBack(make(i));
+		expected.push_back(make(i));
+	}
+
+	CHECK(toStd(vec) == expected);
+
+	Vector<Type> copy(vec);
+	CHECK(toStd(copy) == expected);
+
+	vec.erase(0);
+	vec.erase(100, 199);
+	expected.erase(expected.begin());
+	expected.erase(expected.begin() + 100, expected.begin() + 200);
+	CHECK(toStd(vec) == expected);
+
+	vec.insert(copy.data(), copy.size());
+
+	for (int i = 0; i < 1000; ++i)
+		expected.push_back(make(i));
+
+	CHECK(toStd(vec) == expected);
+
+	copy = vec;
+	CHECK(toStd(copy) == expected);
+}
+
+TEST_CASE("Trivially copyable fast path")
+{
+	static_assert(std::is_trivially_copyable<Pod>::value, "Pod takes the memcpy path");
+	static_assert(!std::is_trivially_copyable<NonTrivialPod>::value, "NonTrivialPod takes the element by element path");
+
+	SUBCASE("int") { checkBulkOperations<int>([](int i) { return i; }); }
+	SUBCASE("double") { checkBulkOperations<double>([](int i) { return i * 0.25; }); }
+	SUBCASE("Pod") { checkBulkOperations<Pod>([](int i) { return Pod{ i, i * 0.5 }; }); }
+	SUBCASE("Not trivially copyable") { checkBulkOperations<NonTrivialPod>([](int i) { return NonTrivialPod(i); }); }
+	SUBCASE("std::string") { checkBulkOperations<std::string>([](int i) { return std::to_string(i); }); }
+}
+
+TEST_CASE("Capacity management")
+{
+	SUBCASE("reserve")
+	{
+		Vector<int> vec;
+		vec.reserve(1000);
+		CHECK(vec.capacity() == 1000);
+		CHECK(vec.empty());
+
+		// Never shrinks
+		vec.reserve(10);
+		CHECK(vec.capacity() == 1000);
+
+		const int* data = vec.data();
+
+		for (int i = 0; i < 1000; ++i)
+			vec.pushBack(i);
+
+		CHECK(vec.data() == data);
+
+		CHECK_THROWS_AS(vec.reserve(std::numeric_limits<std::size_t>::max()), std::length_error);
+		CHECK(vec.capacity() == 1000);
+		CHECK(vec.size() == 1000);
+	}
+
+	SUBCASE("shrinkToFit")
+	{
+		Vector<std::string> vec;
+
+		for (int i = 0; i < 100; ++i)
+			vec.pushBack(std::to_string(i));
+
+		vec.shrinkToFit();
+		CHECK(vec.capacity() == 100);
+		CHECK(vec[99] == "99");
+
+		vec.clear();
+		vec.shrinkToFit();
+		CHECK(vec.capacity() == 0);
+	}
+
+	SUBCASE("resize")
+	{
+		Vector<std::string> vec;
+		vec.resize(10, "seven");
+		CHECK(vec.size() == 10);
+		CHECK(vec[9] == "seven");
+
+		vec.resize(3);
+		CHECK(vec.size() == 3);
+
+		vec.resize(5);
+		CHECK(vec[2] == "seven");
+		CHECK(vec[4].empty());
+
+		Vector<int> ints;
+		ints.pushBack(5);
+		ints.resize(100);
+		CHECK(ints[0] == 5);
+		CHECK(ints[99] == 0);
+	}
+
+	SUBCASE("resize needs only the constructor it uses")
+	{
+		Vector<std::unique_ptr<int>> owners;
+		owners.resize(5);
+		CHECK(owners.size() == 5);
+		CHECK(owners[4] == nullptr);
+
+		// No default constructor
+		Vector<std::reference_wrapper<const int>> refs;
+		const int value = 7;
+		refs.resize(3, std::cref(value));
+		CHECK(refs.size() == 3);
+		CHECK(refs[2].get() == 7);
+	}
+
+	SUBCASE("clear keeps the capacity")
+	{
+		Vector<int> vec;
+
+		for (int i = 0; i < 100; ++i)
+			vec.pushBack(i);
+
+		int capacity = static_cast<int>(vec.capacity());
+		const int* data = vec.data();
+
+		vec.clear();
+		CHECK(vec.empty());
+		CHECK(static_cast<int>(vec.capacity()) == capacity);
+
+		for (int i = 0; i < 100; ++i)
+			vec.pushBack(i);
+
+		CHECK(vec.data() == data);
+	}
+}
+
+TEST_CASE("SmallVector")
+{
+	SUBCASE("Stays inline until it outgrows N")
+	{
+		SmallVector<int, 8> vec;
+		CHECK(vec.capacity() == 8);
+
+		for (int i = 0; i < 8; ++i)
+			vec.pushBack(i);
+
+		CHECK(storedInside(vec));
+
+		vec.pushBack(8);
+		CHECK(!storedInside(vec));
+		CHECK(toStd(vec) == std::vector<int>{ 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+
+		// Back inside once it fits again
+		vec.clear();
+		vec.shrinkToFit();
+		CHECK(storedInside(vec));
+	}
+
+	SUBCASE("Copy and move, small and spilled")
+	{
+		{
+			SmallVector<Counted, 4> small;
+			SmallVector<Counted, 4> big;
+
+			for (int i = 0; i < 3; ++i)
+				small.emplaceBack(i);
+
+			for (int i = 0; i < 20; ++i)
+				big.emplaceBack(i);
+
+			SmallVector<Counted, 4> smallCopy(small);
+			SmallVector<Counted, 4> bigCopy(big);
+			CHECK(storedInside(smallCopy));
+			CHECK(bigCopy.size() == 20);
+			CHECK(bigCopy[19].value == 19);
+
+			const Counted* bigData = big.data();
+			SmallVector<Counted, 4> smallMoved(std::move(small));
+			SmallVector<Counted, 4> bigMoved(std::move(big));
+
+			CHECK(storedInside(smallMoved));
+			CHECK(smallMoved[2].value == 2);
+			CHECK(bigMoved.data() == bigData);
+
+			smallCopy = bigMoved;
+			bigCopy = smallMoved;
+			CHECK(smallCopy.size() == 20);
+			CHECK(bigCopy.size() == 3);
+			CHECK(Counted::live == 3 + 20 + 20 + 3);
+		}
+		CHECK(Counted::live == 0);
+	}
+}
+
+TEST_CASE("Allocators")
+{
+	SUBCASE("Every buffer goes through the allocator")
+	{
+		int allocations = 0;
+		int deallocations = 0;
+		CountingAllocator<std::string> allocator(&allocations, &deallocations);
+
+		{
+			Vector<std::string, GeometricGrowth<>, CountingAllocator<std::string>> vec(allocator);
+
+			for (int i = 0; i < 1000; ++i)
+				vec.pushBack(std::to_string(i));
+
+			CHECK(allocations > 0);
+			CHECK(deallocations == allocations - 1);
+
+			Vector<std::string, GeometricGrowth<>, CountingAllocator<std::string>> copy(vec);
+			CHECK(copy.getAllocator() == allocator);
+			CHECK(copy[999] == "999");
+		}
+
+		CHECK(deallocations == allocations);
+	}
+
+	SUBCASE("Arena")
+	{
+		MonotonicArena arena(1024);
+
+		{
+			Vector<int, GeometricGrowth<>, ArenaAllocator<int>> vec{ ArenaAllocator<int>(arena) };
+			Vector<double, GeometricGrowth<>, ArenaAllocator<double>> other{ ArenaAllocator<double>(arena) };
+
+			for (int i = 0; i < 10000; ++i)
+			{
+				vec.pushBack(i);
+				other.pushBack(i * 0.5);
+			}
+
+			CHECK(vec[9999] == 9999);
+			CHECK(other[9999] == 4999.5);
+			CHECK(arena.bytesUsed() >= 10000 * (sizeof(int) + sizeof(double)));
+
+			Vector<int, GeometricGrowth<>, ArenaAllocator<int>> copy(vec);
+			CHECK(copy.getAllocator() == vec.getAllocator());
+		}
+
+		std::size_t reserved = arena.bytesReserved();
+		arena.reset();
+		CHECK(arena.bytesUsed() == 0);
+		CHECK(arena.bytesReserved() <= reserved);
+
+		// Alignments over max_align_t can not be served
+		CHECK_THROWS_AS(arena.allocate(16, 2 * alignof(std::max_align_t)), std::bad_alloc);
+
+		// Sizes that would wrap around
+		const std::size_t max = std::numeric_limits<std::size_t>::max();
+		std::size_t used = arena.bytesUsed();
+
+		CHECK_THROWS_AS(ArenaAllocator<double>(arena).allocate(max / sizeof(double) + 1), std::bad_array_new_length);
+		arena.allocate(1, 1);
+		CHECK_THROWS_AS(arena.allocate(max - 2, 4), std::bad_alloc);
+		CHECK_THROWS_AS(arena.allocate(max, 1), std::bad_alloc);
+		CHECK(arena.bytesUsed() == used + 1);
+
+		Vector<int, GeometricGrowth<>, ArenaAllocator<int>> vec{ ArenaAllocator<int>(arena) };
+		CHECK_THROWS_AS(vec.reserve(max / 2), std::length_error);
+	}
+}
+
+TEST_CASE("Bulk insert")
+{
+	SUBCASE("Anywhere, against std::vector")
+	{
+		Vector<std::string> vec;
+		std::vector<std::string> expected;
+		std::list<std::string> range = { "a", "b", "c", "d" };
+
+		for (int i = 0; i < 20; ++i)
+		{
+			vec.pushBack(std::to_string(i));
+			expected.push_back(std::to_string(i));
+		}
+
+		vec.insert(0, 2, "front");
+		expected.insert(expected.begin(), 2, "front");
+
+		vec.insert(10, range.begin(), range.end());
+		expected.insert(expected.begin() + 10, range.begin(), range.end());
+
+		vec.insert(static_cast<int>(vec.size()), 3, "back");
+		expected.insert(expected.end(), 3, "back");
+
+		vec.reserve(1000);
+		vec.insert(5, 100, "middle");
+		expected.insert(expected.begin() + 5, 100, "middle");
+
+		CHECK(toStd(vec) == expected);
+		CHECK_THROWS_AS(vec.insert(static_cast<int>(vec.size()) + 1, 1, "past the end"), std::out_of_range);
+	}
+
+	SUBCASE("Trivial elements")
+	{
+		Vector<int> vec;
+		std::vector<int> expected;
+		int values[] = { 100, 101, 102 };
+
+		for (int i = 0; i < 10; ++i)
+		{
+			vec.pushBack(i);
+			expected.push_back(i);
+		}
+
+		vec.insert(3, values, values + 3);
+		expected.insert(expected.begin() + 3, values, values + 3);
+
+		vec.insert(0, 50, -1);
+		expected.insert(expected.begin(), 50, -1);
+
+		CHECK(toStd(vec) == expected);
+	}
+
+	SUBCASE("Value from the shifted part")
+	{
+		Vector<std::string> vec;
+
+		for (int i = 0; i < 6; ++i)
+			vec.pushBack(std::to_string(i));
+
+		vec.reserve(100);
+		vec.insert(1, 3, vec[3]);
+
+		CHECK(toStd(vec) == std::vector<std::string>{ "0", "3", "3", "3", "1", "2", "3", "4", "5" });
+	}
+
+	SUBCASE("Value while growing")
+	{
+		Vector<int> vec;
+
+		for (int i = 0; i < 4; ++i)
+			vec.pushBack(i);
+
+		vec.shrinkToFit();
+		vec.insert(0, 10, vec[3]);
+
+		CHECK(toStd(vec) == std::vector<int>{ 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 0, 1, 2, 3 });
+	}
+
+	SUBCASE("Range from its own tail")
+	{
+		Vector<int> vec;
+
+		for (int i = 0; i < 8; ++i)
+			vec.pushBack(i);
+
+		vec.reserve(100);
+		vec.insert(2, vec.data() + 4, vec.data() + 8);
+
+		CHECK(toStd(vec) == std::vector<int>{ 0, 1, 4, 5, 6, 7, 2, 3, 4, 5, 6, 7 });
+	}
+
+	SUBCASE("Push of its own element")
+	{
+		Vector<std::string> vec;
+		vec.pushBack("first");
+		vec.shrinkToFit();
+
+		for (int i = 0; i < 10; ++i)
+			vec.pushBack(vec[0]);
+
+		CHECK(toStd(vec) == std::vector<std::string>(11, "first"));
+	}
+
+	SUBCASE("In place without allocating")
+	{
+		int allocations = 0;
+		int deallocations = 0;
+		CountingAllocator<std::string> allocator(&allocations, &deallocations);
+
+		// Fewer, as many and more new elements than there are behind the position
+		for (std::size_t count : { 2, 5, 9 })
+		{
+			for (std::size_t position : { 0, 3, 5, 8 })
+			{
+				Vector<std::string, GeometricGrowth<>, CountingAllocator<std::string>> vec(allocator);
+				std::vector<std::string> expected;
+				vec.reserve(20);
+
+				for (int i = 0; i < 8; ++i)
+				{
+					vec.pushBack(std::to_string(i));
+					expected.push_back(std::to_string(i));
+				}
+
+				int before = allocations;
+				vec.insert(position, count, std::string("new"));
+				expected.insert(expected.begin() + position, count, "new");
+
+				std::list<std::string> range = { "a", "b" };
+				vec.insert(position, range.begin(), range.end());
+				expected.insert(expected.begin() + position, range.begin(), range.end());
+
+				CHECK(allocations == before);
+				CHECK(toStd(vec) == expected);
+			}
+		}
+
+		CHECK(deallocations == allocations);
+	}
+}
+
+// Counts the live objects and throws from the copy constructor once copiesLeft runs out (-1 never throws).
+// NothrowMove picks which insert path a Vector takes for it
+template <bool NothrowMove>
+struct Tracked
+{
+	static int live;
+	static int copiesLeft;
+
+	int value;
+
+	Tracked(int value) : value(value) { ++live; }
+
+	Tracked(const Tracked& other) : value(other.value)
+	{
+		if (copiesLeft == 0)
+			throw std::runtime_error("Copy failed!");
+
+		if (copiesLeft > 0)
+			--copiesLeft;
+
+		++live;
+	}
+
+	Tracked(Tracked&& other) noexcept(NothrowMove) : value(other.value) { ++live; }
+
+	Tracked& operator= (const Tracked& other) = default;
+	Tracked& operator= (Tracked&& other) noexcept(NothrowMove) = default;
+
+	~Tracked() { --live; }
+};
+
+template <bool NothrowMove>
+int Tracked<NothrowMove>::live = 0;
+
+template <bool NothrowMove>
+int Tracked<NothrowMove>::copiesLeft = -1;
+
+// Forward iterator over ints that throws when it reaches throwAt
+struct ThrowingIterator
+{
+	using iterator_category = std::forward_iterator_tag;
+	using value_type = int;
+	using difference_type = std::ptrdiff_t;
+	using pointer = const int*;
+	using reference = const int&;
+
+	const int* current;
+	const int* throwAt;
+
+	reference operator* () const
+	{
+		if (current == throwAt)
+			throw std::runtime_error("Read failed!");
+
+		return *current;
+	}
+
+	ThrowingIterator& operator++ () { ++current; return *this; }
+	ThrowingIterator operator++ (int) { ThrowingIterator old = *this; ++current; return old; }
+
+	bool operator== (const ThrowingIterator& other) const { return current == other.current; }
+	bool operator!= (const ThrowingIterator& other) const { return current != other.current; }
+};
+
+template <typename Container>
+std::vector<int> valuesOf(const Container& container)
+{
+	std::vector<int> values;
+
+	for (std::size_t i = 0; i < container.size(); ++i)
+		values.push_back(container[i].value);
+
+	return values;
+}
+
+TEST_CASE("Insert exception safety")
+{
+	std::vector<int> original = { 0, 1, 2, 3, 4 };
+
+	SUBCASE("Throwing copy, shifted in place")
+	{
+		using Element = Tracked<true>;
+		{
+			Vector<Element> vec;
+			vec.reserve(20);
+
+			for (int value : original)
+				vec.emplaceBack(value);
+
+			Element value(9);
+			Element::copiesLeft = 2;
+
+			CHECK_THROWS_AS(vec.insert(2, 3, value), std::runtime_error);
+			Element::copiesLeft = -1;
+
+			CHECK(valuesOf(vec) == original);
+			CHECK(Element::live == 6);
+		}
+		CHECK(Element::live == 0);
+	}
+
+	SUBCASE("Throwing copy of a single element")
+	{
+		using Element = Tracked<true>;
+		{
+			Vector<Element> vec;
+			vec.reserve(20);
+
+			for (int value : original)
+				vec.emplaceBack(value);
+
+			Element value(9);
+			Element::copiesLeft = 0;
+
+			CHECK_THROWS_AS(vec.insert(1, 1, value), std::runtime_error);
+			Element::copiesLeft = -1;
+
+			CHECK(valuesOf(vec) == original);
+		}
+		CHECK(Element::live == 0);
+	}
+
+	SUBCASE("Throwing move takes the reallocating path")
+	{
+		using Element = Tracked<false>;
+		{
+			Vector<Element> vec;
+			vec.reserve(20);
+
+			for (int value : original)
+				vec.emplaceBack(value);
+
+			Element value(9);
+
+			// The new elements go in, then copying the old ones over fails
+			Element::copiesLeft = 4;
+
+			CHECK_THROWS_AS(vec.insert(2, 3, value), std::runtime_error);
+			Element::copiesLeft = -1;
+
+			CHECK(valuesOf(vec) == original);
+			CHECK(vec.capacity() >= 20);
+
+			vec.insert(2, 3, value);
+			CHECK(valuesOf(vec) == std::vector<int>{ 0, 1, 9, 9, 9, 2, 3, 4 });
+		}
+		CHECK(Element::live == 0);
+	}
+
+	SUBCASE("Throwing iterator, trivial elements")
+	{
+		Vector<int> vec(original.data(), original.size());
+		vec.reserve(20);
+
+		int values[] = { 10, 11, 12, 13 };
+		ThrowingIterator first{ values, values + 2 };
+		ThrowingIterator last{ values + 4, values + 2 };
+
+		CHECK_THROWS_AS(vec.insert(1, first, last), std::runtime_error);
+		CHECK(toStd(vec) == original);
+	}
+
+	SUBCASE("Throwing iterator while growing")
+	{
+		Vector<int> vec(original.data(), original.size());
+		vec.shrinkToFit();
+
+		int values[] = { 10, 11, 12, 13 };
+		ThrowingIterator first{ values, values + 3 };
+		ThrowingIterator last{ values + 4, values + 3 };
+
+		CHECK_THROWS_AS(vec.insert(1, first, last), std::runtime_error);
+		CHECK(toStd(vec) == original);
+	}
+}
+
+TEST_CASE("64-bit sizes and indices")
+{
+	static_assert(std::is_same<Vector<int>::size_type, std::size_t>::value, "Sizes are std::size_t");
+	static_assert(std::is_same<decltype(Vector<int>().size()), std::size_t>::value, "size() is a size_type");
+	static_assert(std::is_same<decltype(Vector<int>().capacity()), std::size_t>::value, "capacity() is a size_type");
+
+	SUBCASE("Bad indices")
+	{
+		Vector<int> vec;
+
+		for (int i = 0; i < 10; ++i)
+			vec.pushBack(i);
+
+		// A negative int wraps around to a huge index
+		CHECK_THROWS_AS(vec.at(-1), std::out_of_range);
+		CHECK_THROWS_AS(vec.at(10), std::out_of_range);
+		CHECK(vec.at(9) == 9);
+
+		Vector<int> empty;
+		CHECK_THROWS(empty.erase(0, 0));
+	}
+
+	SUBCASE("Growth near the end of the address space")
+	{
+		const std::size_t max = std::numeric_limits<std::size_t>::max();
+
+		CHECK(GeometricGrowth<>::nextCapacity(max / 4 * 3, max / 4 * 3 + 1) >= max / 4 * 3 + 1);
+		CHECK(GeometricGrowth<>::nextCapacity(max - 10, max - 5) == max - 5);
+		CHECK(DoublingGrowth::nextCapacity(max / 2 + 1, max / 2 + 2) == max / 2 + 2);
+		CHECK(PowerOfTwoGrowth::nextCapacity(0, max / 2 + 2) == max / 2 + 2);
+		CHECK(PowerOfTwoGrowth::nextCapacity(0, std::size_t(1) << 40) == std::size_t(1) << 40);
+		CHECK(FixedStepGrowth<16>::nextCapacity(0, max - 5) == max - 5);
+		CHECK(FixedStepGrowth<16>::nextCapacity(0, max / 16 * 16 - 10) == max / 16 * 16);
+	}
+}
+
+// The kernels against plain loops. Values are multiples of 1/8 small enough that the sums are exact,
+// float dot products round
+template <typename Type>
+void checkKernels()
+{
+	std::mt19937 random(7);
+
+	// Sizes around the vector widths, so the scalar tails run too
+	for (std::size_t size : { 1, 2, 3, 7, 8, 9, 15, 16, 17, 31, 33, 64, 1001 })
+	{
+		Vector<Type> vec;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			double value = static_cast<double>(static_cast<int>(random() % 2001) - 1000);
+			vec.pushBack(static_cast<Type>(std::is_floating_point<Type>::value ? value / 8 : value));
+		}
+
+		double sum = 0;
+		double dot = 0;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			sum += static_cast<double>(vec[i]);
+			dot += static_cast<double>(vec[i]) * static_cast<double>(vec[i]);
+		}
+
+		std::vector<Type> values = toStd(vec);
+		std::size_t argMin = std::min_element(values.begin(), values.end()) - values.begin();
+		std::size_t argMax = std::max_element(values.begin(), values.end()) - values.begin();
+
+		CHECK(static_cast<double>(vec.sum()) == sum);
+		CHECK(static_cast<double>(vec.dot(vec)) == doctest::Approx(dot));
+		CHECK(vec.argMin() == argMin);
+		CHECK(vec.argMax() == argMax);
+		CHECK(vec.minElement() == values[argMin]);
+		CHECK(vec.maxElement() == values[argMax]);
+		CHECK(vec.count(values[size / 2]) == static_cast<std::size_t>(std::count(values.begin(), values.end(), values[size / 2])));
+		CHECK(vec.find(values[size - 1]) == static_cast<std::size_t>(std::find(values.begin(), values.end(), values[size - 1]) - values.begin()));
+		CHECK(vec.find(static_cast<Type>(5000)) == size);
+	}
+
+	Vector<Type> empty;
+	CHECK(static_cast<double>(empty.sum()) == 0);
+	CHECK_THROWS_AS(empty.argMin(), std::logic_error);
+	CHECK_THROWS_AS(empty.argMax(), std::logic_error);
+}
+
+TEST_CASE("SIMD kernels")
+{
+	SUBCASE("float") { checkKernels<float>(); }
+	SUBCASE("double") { checkKernels<double>(); }
+	SUBCASE("int32_t") { checkKernels<std::int32_t>(); }
+	SUBCASE("int64_t") { checkKernels<std::int64_t>(); }
+	SUBCASE("long double, without kernels") { checkKernels<long double>(); }
+}
+
+TEST_CASE("Sorting")
+{
+	std::mt19937_64 random(42);
+
+	SUBCASE("Vector::sort against std::sort")
+	{
+		// Small ones take the introsort, big ones the parallel merge sort
+		for (std::size_t size : { 0, 1, 2, 16, 17, 1000, 300000 })
+		{
+			Vector<double> vec;
+
+			for (std::size_t i = 0; i < size; ++i)
+				vec.pushBack(static_cast<double>(random() % 1000));
+
+			std::vector<double> expected = toStd(vec);
+			std::sort(expected.begin(), expected.end());
+
+			vec.sort();
+			CHECK(toStd(vec) == expected);
+		}
+	}
+
+	SUBCASE("Sorted, reversed and equal inputs")
+	{
+		Vector<int> sorted;
+		Vector<int> reversed;
+		Vector<int> equal;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			sorted.pushBack(i);
+			reversed.pushBack(100000 - i);
+			equal.pushBack(7);
+		}
+
+		sorted.sort();
+		reversed.sort(std::greater<int>());
+		equal.sort();
+
+		CHECK(std::is_sorted(sorted.data(), sorted.data() + sorted.size()));
+		CHECK(std::is_sorted(reversed.data(), reversed.data() + reversed.size(), std::greater<int>()));
+		CHECK(equal[99999] == 7);
+	}
+
+	SUBCASE("Parallel sort on several threads")
+	{
+		// A pool of its own, the machine may have a single core
+		ThreadPool pool(4);
+
+		std::vector<int> ints;
+
+		for (int i = 0; i < (1 << 20); ++i)
+			ints.push_back(static_cast<int>(random() % 100000));
+
+		std::vector<int> intsExpected = ints;
+		std::sort(intsExpected.begin(), intsExpected.end());
+
+		parallelSort(ints.data(), ints.data() + ints.size(), std::less<int>(), pool);
+		CHECK(ints == intsExpected);
+
+		std::vector<std::string> strings;
+
+		for (int i = 0; i < 200000; ++i)
+			strings.push_back("key " + std::to_string(random() % 50000));
+
+		std::vector<std::string> stringsExpected = strings;
+		std::sort(stringsExpected.begin(), stringsExpected.end(), std::greater<std::string>());
+
+		parallelSort(strings.data(), strings.data() + strings.size(), std::greater<std::string>(), pool);
+		CHECK(strings == stringsExpected);
+	}
+
+	SUBCASE("ThreadPool runs every task once")
+	{
+		ThreadPool pool(3);
+		std::vector<std::atomic<int>> runs(1000);
+
+		pool.parallelFor(runs.size(), [&](std::size_t i) { ++runs[i]; });
+
+		bool once = true;
+
+		for (std::atomic<int>& count : runs)
+			once = once && count == 1;
+
+		CHECK(once);
+		CHECK(pool.size() == 3);
+
+		CHECK_THROWS_AS(pool.parallelFor(100, [](std::size_t i) { if (i == 42) throw std::runtime_error("Task failed!"); }), std::runtime_error);
+	}
+}
+
+// Radix sorts random values of Type and compares with std::sort
+template <typename Type>
+void checkRadixSort(std::mt19937_64& random, std::size_t size)
+{
+	Vector<Type> vec;
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		if (std::is_floating_point<Type>::value)
+			vec.pushBack(static_cast<Type>(static_cast<double>(static_cast<std::int64_t>(random() % 2000001) - 1000000) / 64));
+		else
+			vec.pushBack(static_cast<Type>(random()));
+	}
+
+	std::vector<Type> expected = toStd(vec);
+	std::sort(expected.begin(), expected.end());
+
+	vec.radixSort();
+	CHECK(toStd(vec) == expected);
+}
+
+TEST_CASE("Radix sort")
+{
+	std::mt19937_64 random(11);
+
+	SUBCASE("Integers")
+	{
+		for (std::size_t size : { 0, 1, 2, 1000, 400000 })
+		{
+			checkRadixSort<std::int8_t>(random, size);
+			checkRadixSort<std::uint16_t>(random, size);
+			checkRadixSort<std::int32_t>(random, size);
+			checkRadixSort<std::uint32_t>(random, size);
+			checkRadixSort<std::int64_t>(random, size);
+			checkRadixSort<std::uint64_t>(random, size);
+		}
+	}
+
+	SUBCASE("Floating point")
+	{
+		checkRadixSort<float>(random, 50000);
+		checkRadixSort<double>(random, 50000);
+
+		Vector<double> signs;
+		signs.pushBack(1.5);
+		signs.pushBack(-0.0);
+		signs.pushBack(-2.5);
+		signs.pushBack(0.0);
+		signs.pushBack(-std::numeric_limits<double>::infinity());
+		signs.pushBack(std::numeric_limits<double>::infinity());
+		signs.radixSort();
+
+		CHECK(toStd(signs) == std::vector<double>{ -std::numeric_limits<double>::infinity(), -2.5, -0.0, 0.0, 1.5, std::numeric_limits<double>::infinity() });
+	}
+
+	SUBCASE("By key, stable")
+	{
+		struct Record
+		{
+			std::int32_t key;
+			int order;
+		};
+
+		Vector<Record> records;
+
+		for (int i = 0; i < 100000; ++i)
+			records.pushBack(Record{ static_cast<std::int32_t>(random() % 1000) - 500, i });
+
+		std::vector<Record> expected;
+
+		for (std::size_t i = 0; i < records.size(); ++i)
+			expected.push_back(records[i]);
+
+		std::stable_sort(expected.begin(), expected.end(), [](const Record& lhs, const Record& rhs) { return lhs.key < rhs.key; });
+
+		records.radixSort([](const Record& record) { return record.key; });
+
+		bool same = true;
+
+		for (std::size_t i = 0; i < expected.size(); ++i)
+			same = same && records[i].key == expected[i].key && records[i].order == expected[i].order;
+
+		CHECK(same);
+	}
+
+	SUBCASE("A scratch of the caller")
+	{
+		RadixScratch scratch;
+		Vector<std::uint32_t> vec;
+
+		for (int i = 0; i < 10000; ++i)
+			vec.pushBack(static_cast<std::uint32_t>(random()));
+
+		vec.radixSort(scratch);
+		std::size_t capacity = scratch.capacity();
+		CHECK(capacity >= vec.size() * sizeof(std::uint32_t));
+
+		// Smaller inputs reuse it as it is
+		vec.popBack();
+		vec.radixSort(scratch);
+		CHECK(scratch.capacity() == capacity);
+		CHECK(std::is_sorted(vec.data(), vec.data() + vec.size()));
+	}
+
+	SUBCASE("The thread's scratch stays small")
+	{
+		Vector<std::uint64_t> big;
+
+		for (std::size_t i = 0; i < RadixScratch::LOCAL_LIMIT / sizeof(std::uint64_t) * 4; ++i)
+			big.pushBack(random());
+
+		big.radixSort();
+		CHECK(std::is_sorted(big.data(), big.data() + big.size()));
+		CHECK(RadixScratch::local().capacity() <= std::size_t(RadixScratch::LOCAL_LIMIT));
+
+		RadixScratch scratch;
+		scratch.get(1000);
+		CHECK(scratch.capacity() >= 1000);
+		scratch.release();
+		CHECK(scratch.capacity() == 0);
+	}
+}
+
+TEST_CASE("MappedVector")
+{
+	// In the working directory, ctest runs the tests in the build folder
+	const char* path = "VectorTests.mapped";
+	std::remove(path);
+
+	SUBCASE("Survives closing and reopening")
+	{
+		std::vector<std::uint64_t> expected;
+
+		{
+			MappedVector<std::uint64_t> vec(path);
+			CHECK(vec.empty());
+
+			// Over several 64 KiB mapping steps
+			for (std::uint64_t i = 0; i < 50000; ++i)
+			{
+				vec.pushBack(i * i);
+				expected.push_back(i * i);
+			}
+
+			std::uint64_t more[] = { 1, 2, 3 };
+			vec.insert(more, 3);
+			expected.insert(expected.end(), more, more + 3);
+			vec.popBack();
+			expected.pop_back();
+
+			vec.sync();
+		}
+
+		{
+			MappedVector<std::uint64_t> vec(path);
+			CHECK(toStd(vec) == expected);
+			CHECK(vec.at(49999) == expected[49999]);
+			CHECK_THROWS_AS(vec.at(vec.size()), std::out_of_range);
+
+			MappedVector<std::uint64_t> moved(std::move(vec));
+			CHECK(moved.size() == expected.size());
+
+			moved.clear();
+		}
+
+		MappedVector<std::uint64_t> vec(path);
+		CHECK(vec.empty());
+		CHECK_THROWS_AS(vec.back(), std::logic_error);
+		CHECK_THROWS_AS(vec.front(), std::logic_error);
+	}
+
+	SUBCASE("Opening a file leaves its size alone")
+	{
+		Vector<std::uint32_t> values;
+
+		for (std::uint32_t i = 0; i < 1000; ++i)
+			values.pushBack(i * 3);
+
+		{
+			std::ofstream file(path, std::ios::binary);
+			values.writeTo(file);
+		}
+
+		auto fileSize = [path]()
+		{
+			std::ifstream file(path, std::ios::binary | std::ios::ate);
+			return static_cast<std::size_t>(file.tellg());
+		};
+
+		const std::size_t written = fileSize();
+
+		{
+			MappedVector<std::uint32_t> vec(path);
+			CHECK(vec.size() == 1000);
+			CHECK(vec.capacity() == 1000);
+			CHECK(vec[999] == 2997);
+
+			vec.data()[0] = 7;
+		}
+
+		CHECK(fileSize() == written);
+
+		{
+			MappedVector<std::uint32_t> vec(path);
+			CHECK(vec.front() == 7);
+
+			// Growing is what makes the file bigger
+			vec.pushBack(1);
+			CHECK(vec.capacity() > 1000);
+		}
+
+		CHECK(fileSize() > written);
+		CHECK(fileSize() % (1 << 16) == 0);
+	}
+
+	SUBCASE("Rejects a file with another element size")
+	{
+		{
+			MappedVector<std::uint32_t> vec(path);
+			vec.pushBack(1);
+		}
+
+		CHECK_THROWS_AS(MappedVector<std::uint64_t>{ path }, std::runtime_error);
+	}
+
+	std::remove(path);
+}
+
+// The bytes of a stream in a buffer aligned for Type, as a file read into memory would be
+template <typename Type>
+std::vector<Type> alignedBytes(const std::string& bytes)
+{
+	std::vector<Type> buffer(bytes.size() / sizeof(Type) + 1);
+	std::memcpy(buffer.data(), bytes.data(), bytes.size());
+
+	return buffer;
+}
+
+TEST_CASE("Binary serialization")
+{
+	Vector<std::uint64_t> vec;
+
+	for (std::uint64_t i = 0; i < 5000; ++i)
+		vec.pushBack(i * i);
+
+	std::stringstream stream;
+	vec.writeTo(stream);
+	std::string bytes = stream.str();
+
+	CHECK(bytes.size() == VECTOR_FORMAT_DATA_OFFSET + vec.size() * sizeof(std::uint64_t));
+
+	SUBCASE("readFrom")
+	{
+		Vector<std::uint64_t> read;
+		read.readFrom(stream);
+		CHECK(toStd(read) == toStd(vec));
+	}
+
+	SUBCASE("Bad streams keep the old contents")
+	{
+		Vector<std::uint64_t> read;
+		read.pushBack(42);
+
+		std::stringstream shortStream(bytes.substr(0, bytes.size() - 1));
+		CHECK_THROWS_AS(read.readFrom(shortStream), std::runtime_error);
+
+		Vector<std::uint32_t> otherSize;
+		std::stringstream otherStream(bytes);
+		CHECK_THROWS_AS(otherSize.readFrom(otherStream), std::runtime_error);
+
+		std::string badMagic = bytes;
+		badMagic[0] ^= 1;
+		std::stringstream badStream(badMagic);
+		CHECK_THROWS_AS(read.readFrom(badStream), std::runtime_error);
+
+		CHECK(toStd(read) == std::vector<std::uint64_t>{ 42 });
+	}
+
+	SUBCASE("VectorView in place")
+	{
+		std::vector<std::uint64_t> buffer = alignedBytes<std::uint64_t>(bytes);
+
+		VectorView<std::uint64_t> view(buffer.data(), bytes.size());
+		CHECK(view.size() == vec.size());
+		CHECK(view.data() == reinterpret_cast<const std::uint64_t*>(reinterpret_cast<const char*>(buffer.data()) + VECTOR_FORMAT_DATA_OFFSET));
+		CHECK(toStd(view) == toStd(vec));
+		CHECK_THROWS_AS(view.at(view.size()), std::out_of_range);
+
+		CHECK_THROWS_AS(VectorView<std::uint64_t>(buffer.data(), 16), std::runtime_error);
+		CHECK_THROWS_AS(VectorView<std::uint64_t>(buffer.data(), bytes.size() - 8), std::runtime_error);
+		CHECK_THROWS_AS(VectorView<std::uint64_t>(reinterpret_cast<const char*>(buffer.data()) + 4, bytes.size()), std::runtime_error);
+		CHECK_THROWS_AS(VectorView<std::uint32_t>(buffer.data(), bytes.size()), std::runtime_error);
+
+		std::stringstream emptyStream;
+		Vector<std::uint64_t>().writeTo(emptyStream);
+		std::string emptyBytes = emptyStream.str();
+		std::vector<std::uint64_t> emptyBuffer = alignedBytes<std::uint64_t>(emptyBytes);
+
+		VectorView<std::uint64_t> empty(emptyBuffer.data(), emptyBytes.size());
+		CHECK(empty.empty());
+		CHECK_THROWS_AS(empty.back(), std::logic_error);
+		CHECK_THROWS_AS(empty.front(), std::logic_error);
+	}
+
+	SUBCASE("MappedVector files in the same format")
+	{
+		const char* path = "VectorTests.mapped";
+
+		{
+			std::ofstream file(path, std::ios::binary);
+			vec.writeTo(file);
+		}
+
+		{
+			MappedVector<std::uint64_t> mapped(path);
+			CHECK(toStd(mapped) == toStd(vec));
+
+			mapped.pushBack(1);
+			mapped.sync();
+		}
+
+		std::ifstream file(path, std::ios::binary);
+		Vector<std::uint64_t> read;
+		read.readFrom(file);
+		CHECK(read.size() == vec.size() + 1);
+
+		std::remove(path);
+	}
+}
+
+TEST_CASE("remove, removeIf and swapErase")
+{
+	SUBCASE("removeIf against std::remove_if")
+	{
+		{
+			Vector<Counted> vec;
+			std::vector<int> expected;
+
+			for (int i = 0; i < 1000; ++i)
+			{
+				vec.emplaceBack(i % 7);
+
+				if (i % 7 < 3)
+					expected.push_back(i % 7);
+			}
+
+			CHECK(vec.removeIf([](const Counted& el) { return el.value >= 3; }) == 1000 - expected.size());
+			CHECK(vec.size() == expected.size());
+			CHECK(Counted::live == static_cast<int>(expected.size()));
+
+			bool same = true;
+
+			for (std::size_t i = 0; i < expected.size(); ++i)
+				same = same && vec[i].value == expected[i];
+
+			CHECK(same);
+		}
+		CHECK(Counted::live == 0);
+	}
+
+	SUBCASE("remove of one of its own elements")
+	{
+		Vector<std::string> vec;
+
+		for (int i = 0; i < 30; ++i)
+			vec.pushBack(i % 3 == 0 ? "x" : std::to_string(i));
+
+		CHECK(vec.remove(vec[0]) == 10);
+		CHECK(vec.size() == 20);
+		CHECK(vec.remove("missing") == 0);
+		CHECK(vec[0] == "1");
+	}
+
+	SUBCASE("swapErase")
+	{
+		Vector<int> vec;
+
+		for (int i = 0; i < 5; ++i)
+			vec.pushBack(i);
+
+		vec.swapErase(1);
+		CHECK(toStd(vec) == std::vector<int>{ 0, 4, 2, 3 });
+
+		vec.swapErase(3);
+		CHECK(toStd(vec) == std::vector<int>{ 0, 4, 2 });
+		CHECK_THROWS_AS(vec.swapErase(3), std::out_of_range);
+	}
+}
+
+// Moving one throws while fail is set
+struct Fragile
+{
+	static bool fail;
+
+	int value;
+
+	Fragile(int value) : value(value) {}
+	Fragile(const Fragile& other) = default;
+
+	Fragile(Fragile&& other) : value(other.value)
+	{
+		if (fail)
+			throw std::runtime_error("Move failed!");
+	}
+
+	Fragile& operator= (const Fragile& other) = default;
+	Fragile& operator= (Fragile&& other) = default;
+};
+
+bool Fragile::fail = false;
+
+TEST_CASE("SoAVector")
+{
+	SoAVector<int, double, std::string> rows;
+
+	for (int i = 0; i < 100; ++i)
+		rows.pushBack(i, i * 0.5, std::to_string(i));
+
+	SUBCASE("Rows and columns")
+	{
+		CHECK(rows.size() == 100);
+		CHECK(rows[10].get<0>() == 10);
+		CHECK(rows[10].get<2>() == "10");
+		CHECK(static_cast<std::tuple<int, double, std::string>>(rows[7]) == std::make_tuple(7, 3.5, std::string("7")));
+
+		rows[3].get<1>() = -1.0;
+		CHECK(rows.column<1>()[3] == -1.0);
+
+		ColumnSpan<int> ids = rows.column<0>();
+		CHECK(ids.size() == 100);
+		CHECK(&ids[99] == &ids[0] + 99);
+		CHECK_THROWS_AS(rows.at(100), std::out_of_range);
+	}
+
+	SUBCASE("Erase and resize act on every column")
+	{
+		rows.erase(0);
+		rows.swapErase(0);
+		rows.popBack();
+
+		CHECK(rows.size() == 97);
+		CHECK(rows[0].get<0>() == 99);
+		CHECK(rows[1].get<2>() == "2");
+		CHECK(rows.column<2>().size() == 97);
+
+		rows.resize(200);
+		CHECK(rows[199].get<0>() == 0);
+		CHECK(rows[199].get<2>().empty());
+
+		rows.clear();
+		CHECK(rows.empty());
+		CHECK_THROWS_AS(rows.popBack(), std::logic_error);
+	}
+
+	SUBCASE("A failed pushBack leaves the columns the same length")
+	{
+		SoAVector<int, Fragile> fragile;
+		fragile.pushBack(1, Fragile(1));
+		fragile.shrinkToFit();
+
+		Fragile value(2);
+		Fragile::fail = true;
+		CHECK_THROWS_AS(fragile.pushBack(2, value), std::runtime_error);
+		Fragile::fail = false;
+
+		CHECK(fragile.size() == 1);
+		CHECK(fragile.column<0>().size() == 1);
+		CHECK(fragile.column<1>().size() == 1);
+	}
+}
+
+TEST_CASE("ConcurrentVector")
+{
+	SUBCASE("Appends from several threads all land")
+	{
+		ConcurrentVector<std::size_t> values;
+		const std::size_t threadCount = 4;
+		const std::size_t perThread = 20000;
+
+		std::vector<std::thread> threads;
+		for (std::size_t t = 0; t < threadCount; ++t)
+		{
+			threads.emplace_back([&values, t, perThread]()
+			{
+				for (std::size_t i = 0; i < perThread; ++i)
+					values.pushBack(t * perThread + i);
+			});
+		}
+
+		for (std::thread& thread : threads)
+			thread.join();
+
+		REQUIRE(values.size() == threadCount * perThread);
+
+		std::vector<std::size_t> seen;
+		for (std::size_t i = 0; i < values.size(); ++i)
+		{
+			REQUIRE(values.isPublished(i));
+			seen.push_back(values[i]);
+		}
+
+		std::sort(seen.begin(), seen.end());
+		for (std::size_t i = 0; i < seen.size(); ++i)
+			REQUIRE(seen[i] == i);
+	}
+
+	SUBCASE("Addresses stay put while growing")
+	{
+		ConcurrentVector<std::string> strings;
+		strings.pushBack("first");
+		const std::string* first = &strings[0];
+
+		for (int i = 0; i < 10000; ++i)
+			strings.emplaceBack(std::to_string(i));
+
+		CHECK(&strings[0] == first);
+		CHECK(strings[0] == "first");
+		CHECK(strings.at(10000) == "9999");
+		CHECK_FALSE(strings.isPublished(10001));
+		CHECK_THROWS_AS(strings.at(10001), std::out_of_range);
+	}
+}
+
+TEST_CASE("SegmentedVector")
+{
+	SegmentedVector<std::string, 16> strings;
+
+	for (int i = 0; i < 100; ++i)
+		strings.pushBack(std::to_string(i));
+
+	SUBCASE("Growing keeps addresses")
+	{
+		const std::string* first = &strings[0];
+		const std::string* last = &strings.back();
+
+		for (int i = 100; i < 1000; ++i)
+			strings.emplaceBack(std::to_string(i));
+
+		CHECK(&strings[0] == first);
+		CHECK(&strings[99] == last);
+		CHECK(strings.size() == 1000);
+		CHECK(strings[999] == "999");
+		CHECK_THROWS_AS(strings.at(1000), std::out_of_range);
+	}
+
+	SUBCASE("Chunks are walked in order")
+	{
+		std::size_t seen = 0;
+		std::size_t chunks = 0;
+
+		strings.forEachChunk([&](std::string* data, std::size_t count)
+		{
+			for (std::size_t i = 0; i < count; ++i)
+				CHECK(data[i] == std::to_string(seen + i));
+
+			seen += count;
+			++chunks;
+		});
+
+		CHECK(seen == 100);
+		CHECK(chunks == 7);
+	}
+
+	SUBCASE("Copies, pops and shrinking")
+	{
+		SegmentedVector<std::string, 16> copy(strings);
+		strings.popBack();
+		strings.clear();
+		CHECK(strings.empty());
+		CHECK(strings.capacity() >= 100);
+
+		strings.shrinkToFit();
+		CHECK(strings.capacity() == 0);
+
+		CHECK(copy.size() == 100);
+		CHECK(copy.front() == "0");
+		CHECK(copy.back() == "99");
+
+		strings = std::move(copy);
+		CHECK(strings.size() == 100);
+		CHECK(strings[50] == "50");
+	}
+
+	SUBCASE("back and front of an empty vector")
+	{
+		strings.clear();
+		CHECK_THROWS_AS(strings.back(), std::logic_error);
+		CHECK_THROWS_AS(strings.front(), std::logic_error);
+	}
+
+	SUBCASE("A copy that throws cleans up")
+	{
+		using Element = Tracked<true>;
+		{
+			SegmentedVector<Element> vec;
+
+			for (int i = 0; i < 1000; ++i)
+				vec.emplaceBack(i);
+
+			Element::copiesLeft = 700;
+			CHECK_THROWS_AS(SegmentedVector<Element>{ vec }, std::runtime_error);
+			Element::copiesLeft = -1;
+
+			CHECK(Element::live == 1000);
+		}
+		CHECK(Element::live == 0);
+	}
+}
+
+TEST_CASE("Aligned storage")
+{
+	SUBCASE("Every buffer is aligned")
+	{
+		AlignedVector<float, 64> floats;
+		CHECK(floats.storageInfo().alignment == 0);
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			floats.pushBack(float(i));
+			REQUIRE(floats.storageInfo().alignment >= 64);
+		}
+
+		floats.shrinkToFit();
+		CHECK(floats.storageInfo().alignment >= 64);
+		CHECK_FALSE(floats.storageInfo().isInline);
+		CHECK_FALSE(floats.storageInfo().hugePages);
+		CHECK(floats[999] == 999.0f);
+	}
+
+	SUBCASE("Small buffers do not ask for huge pages")
+	{
+		AlignedVector<char, 4096, PageMode::Huge> bytes;
+		bytes.reserve(4096);
+		CHECK(bytes.storageInfo().alignment >= 4096);
+		CHECK_FALSE(bytes.storageInfo().hugePages);
+	}
+
+	SUBCASE("Huge pages are reported for the buffer asked about")
+	{
+		using Allocator = AlignedAllocator<char, 64, PageMode::Huge>;
+		const std::size_t bigBytes = std::size_t(4) << 20;
+
+		AlignedVector<char, 64, PageMode::Huge> big;
+		big.reserve(bigBytes);
+
+		// Whether madvise took it depends on the kernel, but no other buffer may claim it
+		std::vector<char> other(16);
+		CHECK_FALSE(Allocator().usesHugePages(other.data(), bigBytes));
+
+		bool advised = big.storageInfo().hugePages;
+		CHECK(Allocator().usesHugePages(big.data(), big.capacity()) == advised);
+
+		const char* oldData = big.data();
+		big.resize(1, 'x');
+		big.shrinkToFit();
+		CHECK_FALSE(Allocator().usesHugePages(oldData, bigBytes));
+		CHECK_FALSE(big.storageInfo().hugePages);
+	}
+
+	SUBCASE("Sizes that overflow are rejected")
+	{
+		using HugeAllocator = AlignedAllocator<char, 64, PageMode::Huge>;
+		const std::size_t max = std::numeric_limits<std::size_t>::max();
+
+		CHECK_THROWS_AS(AlignedAllocator<std::uint64_t>().allocate(max / sizeof(std::uint64_t) + 1), std::bad_array_new_length);
+		CHECK_THROWS_AS(HugeAllocator().allocate(max - 1), std::bad_array_new_length);
+		CHECK(HugeAllocator::max_size() == max - HUGE_PAGE_SIZE);
+
+		AlignedVector<std::uint64_t> vec;
+		vec.pushBack(1);
+		CHECK_THROWS_AS(vec.reserve(max / 4), std::length_error);
+		CHECK(vec.size() == 1);
+		CHECK(vec[0] == 1);
+	}
+
+	SUBCASE("Inline storage is reported")
+	{
+		SmallVector<int, 8> small;
+		small.pushBack(1);
+		CHECK(small.storageInfo().isInline);
+		CHECK(small.storageInfo().alignment >= alignof(int));
+	}
+}
+
+TEST_CASE("SharedVector")
+{
+	Vector<std::string> values;
+
+	for (int i = 0; i < 10; ++i)
+		values.pushBack(std::to_string(i));
+
+	SharedVector<std::string> shared(values);
+	SharedVector<std::string> copy(shared);
+
+	SUBCASE("Copies share until one changes")
+	{
+		CHECK(shared.isShared());
+		CHECK(shared.useCount() == 2);
+		CHECK(shared.data() == copy.data());
+
+		copy.pushBack("10");
+
+		CHECK_FALSE(shared.isShared());
+		CHECK(shared.size() == 10);
+		CHECK(copy.size() == 11);
+		CHECK(shared.data() != copy.data());
+	}
+
+	SUBCASE("Const reads keep sharing")
+	{
+		const SharedVector<std::string>& view = copy;
+		CHECK(view[3] == "3");
+		CHECK(view.at(9) == "9");
+		CHECK(view.front() == "0");
+		CHECK(view.back() == "9");
+		CHECK(shared.data() == copy.data());
+		CHECK_THROWS_AS(view.at(10), std::out_of_range);
+	}
+
+	SUBCASE("Every change unshares")
+	{
+		copy[0] = "zero";
+		CHECK(shared[0] == "0");
+		CHECK(copy[0] == "zero");
+
+		SharedVector<std::string> again(shared);
+		again.erase(0, 1);
+		again.insert(shared.data(), 2);
+		CHECK(again.size() == 10);
+		CHECK(again[8] == "0");
+		CHECK(shared.size() == 10);
+		CHECK(shared[2] == "2");
+	}
+
+	SUBCASE("Pushing an element of the shared buffer")
+	{
+		shared.pushBack(copy[0]);
+		CHECK(shared.back() == "0");
+		CHECK(copy.size() == 10);
+	}
+
+	SUBCASE("References handed out keep later copies apart")
+	{
+		std::string& indexed = copy[1];
+		std::string& checked = copy.at(2);
+		std::string& added = copy.emplaceBack("10");
+
+		SharedVector<std::string> again(copy);
+		CHECK_FALSE(again.isShared());
+		CHECK(again.data() != copy.data());
+
+		indexed = "one";
+		checked = "two";
+		added = "ten";
+
+		const SharedVector<std::string>& read = again;
+		CHECK(read[1] == "1");
+		CHECK(read[2] == "2");
+		CHECK(read.back() == "10");
+		CHECK(copy[1] == "one");
+		CHECK(shared[1] == "1");
+
+		SharedVector<std::string> assigned;
+		assigned = copy;
+		CHECK(assigned.data() != copy.data());
+		CHECK(assigned.size() == 11);
+
+		// clear ends the references, so the buffer can be shared again
+		copy.clear();
+		copy.pushBack("new");
+		SharedVector<std::string> shares(copy);
+		CHECK(shares.isShared());
+		CHECK(shares.data() == copy.data());
+	}
+
+	SUBCASE("Every change after sharing again leaves the other handle alone")
+	{
+		std::vector<std::function<void(SharedVector<std::string>&)>> changes =
+		{
+			[](SharedVector<std::string>& vec) { vec.pushBack("x"); },
+			[](SharedVector<std::string>& vec) { std::string value = "x"; vec.pushBack(std::move(value)); },
+			[](SharedVector<std::string>& vec) { vec.emplaceBack("x"); },
+			[](SharedVector<std::string>& vec) { vec[0] = "x"; },
+			[](SharedVector<std::string>& vec) { vec.at(0) = "x"; },
+			[](SharedVector<std::string>& vec) { vec.insert(vec.data(), 2); },
+			[](SharedVector<std::string>& vec) { vec.erase(0); },
+			[](SharedVector<std::string>& vec) { vec.erase(0, 3); },
+			[](SharedVector<std::string>& vec) { vec.resize(3); },
+			[](SharedVector<std::string>& vec) { vec.reserve(100); vec.pushBack("x"); },
+			[](SharedVector<std::string>& vec) { vec.popBack(); },
+			[](SharedVector<std::string>& vec) { vec.clear(); }
+		};
+
+		for (const auto& change : changes)
+		{
+			SharedVector<std::string> first(values);
+			SharedVector<std::string> second(first);
+			change(second);
+
+			// Share what the change left behind, then change it again through the new handle
+			std::vector<std::string> before = toStd(second.vector());
+			SharedVector<std::string> third(second);
+			change(third);
+
+			CHECK(toStd(first.vector()) == toStd(values));
+			CHECK(toStd(second.vector()) == before);
+		}
+	}
+
+	SUBCASE("Empty handles")
+	{
+		SharedVector<std::string> empty;
+		CHECK(empty.useCount() == 0);
+		CHECK(empty.vector().empty());
+		CHECK_THROWS_AS(empty.popBack(), std::logic_error);
+
+		copy.clear();
+		CHECK(copy.empty());
+		CHECK(shared.size() == 10);
+	}
+}
+
+TEST_CASE("Iterators")
+{
+	Vector<int> vec;
+
+	for (int i = 0; i < 100; ++i)
+		vec.pushBack(99 - i);
+
+	SUBCASE("Standard algorithms")
+	{
+		std::sort(vec.begin(), vec.end());
+		CHECK(std::is_sorted(vec.cbegin(), vec.cend()));
+		CHECK(std::accumulate(vec.begin(), vec.end(), 0) == 4950);
+		CHECK(std::find(vec.begin(), vec.end(), 42) - vec.begin() == 42);
+		CHECK(vec.end() - vec.begin() == 100);
+
+		std::fill(vec.begin(), vec.begin() + 10, -1);
+		CHECK(std::count(vec.begin(), vec.end(), -1) == 10);
+	}
+
+	SUBCASE("Range-for and reverse iteration")
+	{
+		int expected = 99;
+		for (int& value : vec)
+			CHECK(value == expected--);
+
+		std::vector<int> reversed(vec.rbegin(), vec.rend());
+		CHECK(reversed.front() == 0);
+		CHECK(reversed.back() == 99);
+
+		const Vector<int>& view = vec;
+		CHECK(*view.crbegin() == 0);
+		CHECK(view.begin() == view.data());
+	}
+
+	SUBCASE("Empty vectors")
+	{
+		Vector<int> empty;
+		CHECK(empty.begin() == empty.end());
+		CHECK(empty.rbegin() == empty.rend());
+	}
+
+	SUBCASE("SoAVector columns")
+	{
+		SoAVector<int, float> rows;
+
+		for (int i = 0; i < 10; ++i)
+			rows.pushBack(i, float(i));
+
+		int sum = 0;
+		for (int id : rows.column<0>())
+			sum += id;
+
+		CHECK(sum == 45);
+	}
+}
+
+TEST_CASE("BitVector")
+{
+	std::mt19937_64 random(3);
+
+	// One set bit in every oneIn on average, checked against a plain scan
+	auto checkAgainstScan = [&](std::size_t size, std::size_t oneIn, std::size_t rankStride)
+	{
+		BitVector bits(size);
+		std::vector<std::size_t> positions;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (random() % oneIn == 0)
+			{
+				bits.set(i);
+				positions.push_back(i);
+			}
+		}
+
+		bits.buildRankIndex();
+		CHECK(bits.hasRankIndex());
+		CHECK(bits.count() == positions.size());
+
+		bool selectsMatch = true;
+
+		for (std::size_t k = 0; k < positions.size(); ++k)
+			selectsMatch = selectsMatch && bits.select(k) == positions[k];
+
+		CHECK(selectsMatch);
+		CHECK(bits.select(positions.size()) == size);
+
+		bool ranksMatch = true;
+		std::size_t below = 0;
+
+		for (std::size_t i = 0; i <= size; ++i)
+		{
+			if (i % rankStride == 0 || i == size)
+				ranksMatch = ranksMatch && bits.rank(i) == below;
+
+			if (i < size && bits[i])
+				++below;
+		}
+
+		CHECK(ranksMatch);
+	};
+
+	SUBCASE("Small")
+	{
+		checkAgainstScan(1, 1, 1);
+		checkAgainstScan(777, 3, 1);
+		checkAgainstScan(4097, 64, 1);
+	}
+
+	SUBCASE("Dense")
+	{
+		checkAgainstScan(3000000, 2, 7);
+	}
+
+	SUBCASE("Sparse")
+	{
+		// A select sample spans more than a million bits here, its positions are kept directly
+		checkAgainstScan(20000000, 3000, 13);
+	}
+
+	SUBCASE("Empty and full")
+	{
+		BitVector none(100000);
+		none.buildRankIndex();
+		CHECK(none.select(0) == none.size());
+		CHECK(none.rank(none.size()) == 0);
+
+		BitVector all(100000, true);
+		all.buildRankIndex();
+		CHECK(all.select(99999) == 99999);
+		CHECK(all.rank(54321) == 54321);
+	}
+
+	SUBCASE("Word operations")
+	{
+		BitVector evens(130);
+		BitVector low(130);
+
+		for (std::size_t i = 0; i < 130; ++i)
+		{
+			evens.set(i, i % 2 == 0);
+			low.set(i, i < 65);
+		}
+
+		CHECK((evens & low).count() == 33);
+		CHECK((evens | low).count() == 97);
+		CHECK((evens ^ low).count() == 64);
+		CHECK((~evens).count() == 65);
+		CHECK((~evens) != evens);
+
+		BitVector shorter(129);
+		CHECK_THROWS_AS(evens &= shorter, std::invalid_argument);
+
+		evens.pushBack(true);
+		CHECK(evens.size() == 131);
+		CHECK(evens.count() == 66);
+		evens.popBack();
+		CHECK(evens.at(128));
+		CHECK_THROWS_AS(evens.at(130), std::out_of_range);
+	}
+
+	SUBCASE("A change makes the index stale")
+	{
+		BitVector bits(1000);
+		bits.buildRankIndex();
+		bits.set(10);
+
+		CHECK_FALSE(bits.hasRankIndex());
+		CHECK_THROWS_AS(bits.rank(500), std::logic_error);
+
+		bits.buildRankIndex();
+		CHECK(bits.rank(500) == 1);
+		CHECK(bits.select(0) == 10);
+
+		BitVector empty;
+		CHECK_THROWS_AS(empty.popBack(), std::logic_error);
+	}
+}
+
+TEST_CASE("RingBuffer")
+{
+	SUBCASE("Overwrite keeps the newest elements")
+	{
+		RingBuffer<int> ring(4, RingMode::Overwrite);
+
+		for (int i = 0; i < 10; ++i)
+			ring.pushBack(i);
+
+		CHECK(ring.full());
+		CHECK(ring.size() == 4);
+		CHECK(ring.front() == 6);
+		CHECK(ring.back() == 9);
+
+		ring.pushFront(-1);
+		CHECK(ring.front() == -1);
+		CHECK(ring.back() == 8);
+		CHECK_THROWS_AS(RingBuffer<int>(0, RingMode::Overwrite), std::invalid_argument);
+	}
+
+	SUBCASE("Grows at both ends")
+	{
+		RingBuffer<std::string> grow;
+
+		for (int i = 0; i < 100; ++i)
+		{
+			grow.pushBack(std::to_string(i));
+			grow.pushFront(std::to_string(-i));
+		}
+
+		CHECK(grow.size() == 200);
+		CHECK(grow.front() == "-99");
+		CHECK(grow.back() == "99");
+		CHECK(grow[100] == "0");
+		CHECK_THROWS_AS(grow.at(200), std::out_of_range);
+
+		RingBuffer<std::string> copy(grow);
+		grow.popFront();
+		grow.popBack();
+		CHECK(grow.size() == 198);
+		CHECK(copy.size() == 200);
+		CHECK(copy[199] == "99");
+
+		grow.clear();
+		CHECK(grow.empty());
+		CHECK_THROWS_AS(grow.popFront(), std::logic_error);
+		CHECK_THROWS_AS(grow.popBack(), std::logic_error);
+		CHECK_THROWS_AS(grow.front(), std::logic_error);
+		CHECK_THROWS_AS(grow.back(), std::logic_error);
+
+		const RingBuffer<std::string>& view = grow;
+		CHECK_THROWS_AS(view.front(), std::logic_error);
+		CHECK_THROWS_AS(view.back(), std::logic_error);
+	}
+
+	SUBCASE("Works as a FIFO")
+	{
+		RingBuffer<int> queue;
+		int next = 0;
+
+		for (int i = 0; i < 1000; ++i)
+		{
+			queue.pushBack(i);
+
+			if (i % 3 == 0)
+			{
+				CHECK(queue.front() == next++);
+				queue.popFront();
+			}
+		}
+
+		CHECK(queue.size() == 1000u - next);
+		CHECK(queue.front() == next);
+	}
+
+	SUBCASE("SPSC between two threads")
+	{
+		SpscRingBuffer<std::uint64_t> queue(1000);
+		CHECK(queue.capacity() == 1024);
+
+		const std::uint64_t count = 200000;
+		std::uint64_t sum = 0;
+		bool ordered = true;
+
+		std::thread consumer([&]()
+		{
+			std::uint64_t expected = 0;
+			std::uint64_t value;
+
+			while (expected < count)
+			{
+				if (queue.tryPop(value))
+				{
+					ordered = ordered && value == expected++;
+					sum += value;
+				}
+				else
+				{
+					std::this_thread::yield();
+				}
+			}
+		});
+
+		for (std::uint64_t i = 0; i < count; ++i)
+		{
+			while (!queue.tryPush(i))
+				std::this_thread::yield();
+		}
+
+		consumer.join();
+
+		CHECK(ordered);
+		CHECK(sum == count * (count - 1) / 2);
+		CHECK(queue.empty());
+	}
+}
+
+TEST_CASE("CompressedIntVector")
+{
+	std::mt19937_64 random(11);
+	Vector<std::uint64_t> sorted;
+	Vector<std::uint64_t> unsorted;
+	std::uint64_t id = 0;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		id += random() % 100;
+		sorted.pushBack(id);
+		unsorted.pushBack(random());
+	}
+
+	SUBCASE("Round trip")
+	{
+		CompressedIntVector packed(sorted.data(), sorted.size());
+		CompressedIntVector wide(unsorted.data(), unsorted.size());
+
+		CHECK(toStd(packed.toVector()) == toStd(sorted));
+		CHECK(toStd(wide.toVector()) == toStd(unsorted));
+		CHECK(packed[999] == sorted[999]);
+		CHECK(wide[500] == unsorted[500]);
+		CHECK(packed.bytesUsed() < sorted.size() * sizeof(std::uint64_t));
+		CHECK_THROWS_AS(packed.at(1000), std::out_of_range);
+	}
+
+	SUBCASE("Appends and blocks")
+	{
+		CompressedIntVector packed;
+
+		for (std::size_t i = 0; i < sorted.size(); ++i)
+			packed.pushBack(sorted[i]);
+
+		CHECK(packed.size() == 1000);
+		CHECK(packed.blockCount() == 8);
+
+		std::uint64_t block[CompressedIntVector::BLOCK_SIZE];
+		CHECK(packed.decodeBlock(7, block) == 1000 - 7 * CompressedIntVector::BLOCK_SIZE);
+		CHECK(block[0] == sorted[7 * CompressedIntVector::BLOCK_SIZE]);
+
+		CHECK(toStd(packed.toVector()) == toStd(sorted));
+
+		packed.clear();
+		CHECK(packed.empty());
+		CHECK(packed.blockCount() == 0);
+	}
+
+	SUBCASE("Random reads")
+	{
+		CompressedIntVector packed(sorted.data(), sorted.size());
+		CompressedIntVector wide(unsorted.data(), unsorted.size());
+
+		bool same = true;
+
+		for (int i = 0; i < 100000; ++i)
+		{
+			std::size_t index = static_cast<std::size_t>(random() % sorted.size());
+			same = same && packed[index] == sorted[index] && wide[index] == unsorted[index];
+		}
+
+		CHECK(same);
+
+		// Right before, on and after the anchors
+		for (std::size_t index : { 0, 31, 32, 33, 63, 64, 95, 96, 127, 128, 991, 999 })
+		{
+			CHECK(packed[index] == sorted[index]);
+			CHECK(wide[index] == unsorted[index]);
+		}
+	}
+
+	SUBCASE("Equal values take no bits")
+	{
+		CompressedIntVector packed;
+
+		for (int i = 0; i < 4096; ++i)
+			packed.pushBack(7);
+
+		CHECK(packed[4095] == 7);
+		CHECK(packed.bytesUsed() < 4096);
+	}
+}
+
+TEST_CASE("Stats")
+{
+	resetVectorStats();
+
+	Vector<std::string> vec;
+	vec.reserve(4);
+
+	for (int i = 0; i < 10; ++i)
+		vec.pushBack(std::to_string(i));
+
+	vec.erase(0);
+	Vector<std::string> copy(vec);
+
+	if (!VECTOR_STATS_ENABLED)
+	{
+		CHECK(std::is_empty<VectorStatsHolder>::value);
+		CHECK(vec.stats().allocations == 0);
+		CHECK(copy.stats().elementCopies == 0);
+		CHECK(globalVectorStats().allocations == 0);
+		return;
+	}
+
+	// 4, 6, 9 and 13 slots, moving 4, 6 and 9 elements on the way, and 9 more for the erase
+	VectorStats stats = vec.stats();
+	CHECK(stats.allocations == 4);
+	CHECK(stats.reallocations == 3);
+	CHECK(stats.resizeReallocations == 0);
+	CHECK(stats.elementMoves == 4 + 6 + 9 + 9);
+	CHECK(stats.elementCopies == 0);
+	CHECK(stats.bytesAllocated == sizeof(std::string) * (4 + 6 + 9 + 13));
+	CHECK(stats.peakCapacityBytes == sizeof(std::string) * 13);
+
+	CHECK(copy.stats().allocations == 1);
+	CHECK(copy.stats().elementCopies == 9);
+
+	VectorStats totals = globalVectorStats();
+	CHECK(totals.allocations == 5);
+	CHECK(totals.elementCopies == 9);
+
+	vec.resize(100);
+	CHECK(vec.stats().resizeReallocations == 1);
+
+	// Every element built from another one counts, whichever way it got in
+	std::string value = "value";
+	Vector<std::string> copies;
+
+	copies.pushBack(value);
+	copies.emplaceBack(value);
+	CHECK(copies.stats().elementCopies == 2);
+
+	copies.pushBack(std::string("moved"));
+	copies.emplaceBack(3, 'c');
+	CHECK(copies.stats().elementCopies == 2);
+
+	copies.insert(0, 2, value);
+	CHECK(copies.stats().elementCopies == 4);
+
+	// One for the copy of the shifted element, one for the insert
+	copies.insert(0, 1, copies[3]);
+	CHECK(copies.stats().elementCopies == 6);
+
+	copies.insert(copy.data(), 3);
+	copies.insert(1, copy.begin(), copy.begin() + 2);
+	CHECK(copies.stats().elementCopies == 11);
+
+	copies.resize(copies.size() + 4, value);
+	copies.resize(copies.size() + 50, value);
+	copies.resize(copies.size() + 2);
+	CHECK(copies.stats().elementCopies == 65);
+
+	Vector<std::string> fromData(copy.data(), 3);
+	CHECK(fromData.stats().elementCopies == 3);
+}
+
+int main()
+{
+	return doctest::Context().run();
+}
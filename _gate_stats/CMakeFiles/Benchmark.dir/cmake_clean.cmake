@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "Benchmark"
+  "Benchmark.pdb"
+  "CMakeFiles/Benchmark.dir/Vector/Benchmark.cpp.o"
+  "CMakeFiles/Benchmark.dir/Vector/Benchmark.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VectorStatsTests.dir/Vector/tests/VectorTests.cpp.o"
+  "CMakeFiles/VectorStatsTests.dir/Vector/tests/VectorTests.cpp.o.d"
+  "VectorStatsTests"
+  "VectorStatsTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VectorStatsTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VectorTests.dir/Vector/tests/VectorTests.cpp.o"
+  "CMakeFiles/VectorTests.dir/Vector/tests/VectorTests.cpp.o.d"
+  "VectorTests"
+  "VectorTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VectorTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/VectorVsStd.dir/Vector/VectorVsStd.cpp.o"
+  "CMakeFiles/VectorVsStd.dir/Vector/VectorVsStd.cpp.o.d"
+  "CMakeFiles/VectorVsStd.dir/root/repo/String/String/String.cpp.o"
+  "CMakeFiles/VectorVsStd.dir/root/repo/String/String/String.cpp.o.d"
+  "VectorVsStd"
+  "VectorVsStd.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/VectorVsStd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/Vector
+# Build directory: /root/repo/_gate_stats
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(VectorTests "/root/repo/_gate_stats/VectorTests")
+set_tests_properties(VectorTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/Vector/CMakeLists.txt;36;add_test;/root/repo/Vector/CMakeLists.txt;0;")
+add_test(VectorStatsTests "/root/repo/_gate_stats/VectorStatsTests")
+set_tests_properties(VectorStatsTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/Vector/CMakeLists.txt;42;add_test;/root/repo/Vector/CMakeLists.txt;0;")